@@ -0,0 +1,72 @@
+// -*- coding: utf-8 -*-
+#include <nanobench.h>  // for Bench, doNotOptimizeAway
+
+#include <cstdint>                           // for uint32_t
+#include <netoptim/csr_graph.hpp>            // for CsrGraph
+#include <netoptim/cycle_ratio_engines.hpp>  // for min_cycle_ratio, CycleRatioEngine
+#include <string>                            // for string
+#include <utility>                           // for pair
+#include <vector>                            // for vector
+
+#include "../../test/source/random_graph.tpp"  // for create_random_graph
+
+/**
+ * @file bench_cycle_ratio.cpp
+ * @brief Compare the minimum cycle ratio engines on generated graphs
+ *
+ * Every graph is a ring through all nodes (so it is strongly connected)
+ * plus random chords. Karp keeps an n x n table and is only run on the
+ * small graphs.
+ */
+
+namespace {
+
+    using Edge = std::pair<int, int>;  // (cost, time)
+
+    struct Shape {
+        const char* name;
+        uint32_t num_nodes;
+        uint32_t num_edges;
+        int max_time;
+    };
+
+}  // namespace
+
+auto main() -> int {
+    const auto shapes = std::vector<Shape>{
+        {"dense  n=100 m=5000 unit", 100, 5000, 1},
+        {"dense  n=100 m=5000", 100, 5000, 10},
+        {"sparse n=1000 m=4000 unit", 1000, 4000, 1},
+        {"sparse n=50000 m=200000", 50000, 200000, 10},
+    };
+    const auto engines = std::vector<std::pair<const char*, CycleRatioEngine>>{
+        {"howard", CycleRatioEngine::Howard},
+        {"karp", CycleRatioEngine::Karp},
+        {"yto", CycleRatioEngine::YoungTarjanOrlin},
+        {"lawler", CycleRatioEngine::Lawler},
+    };
+    const auto get_cost = [](const Edge& edge) -> double { return edge.first; };
+    const auto get_time = [](const Edge& edge) -> double { return edge.second; };
+
+    for (const auto& shape : shapes) {
+        const auto num_chords = shape.num_edges - shape.num_nodes;
+        const auto gra
+            = create_random_graph<Edge>(shape.num_nodes, num_chords, 2024, shape.max_time);
+        auto bench = ankerl::nanobench::Bench().title(shape.name).relative(true).minEpochIterations(
+            shape.num_nodes > 10000 ? 1 : 5);
+        for (const auto& [name, engine] : engines) {
+            const auto karp_fits = shape.max_time == 1 && shape.num_nodes <= 1000;
+            if (engine == CycleRatioEngine::Karp && !karp_fits) {
+                continue;  // Karp needs unit times and O(n^2) memory
+            }
+            bench.run(name, [&, engine = engine] {
+                auto dist = std::vector<double>(gra.num_nodes(), 0.0);
+                auto r = 1000.0;
+                auto cycle = min_cycle_ratio(gra, r, get_cost, get_time, dist, engine);
+                ankerl::nanobench::doNotOptimizeAway(r);
+                ankerl::nanobench::doNotOptimizeAway(cycle);
+            });
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+// -*- coding: utf-8 -*-
+#include <nanobench.h>  // for Bench, doNotOptimizeAway
+
+#include <algorithm>                       // for min, max
+#include <cstdint>                         // for uint32_t
+#include <cstdio>                          // for printf
+#include <ellalgo/cutting_plane.hpp>       // for cutting_plane_optim
+#include <ellalgo/ell.hpp>                 // for Ell
+#include <limits>                          // for numeric_limits
+#include <netoptim/csr_graph.hpp>          // for CsrGraph
+#include <netoptim/optimal_scaling.hpp>    // for optimal_scaling
+#include <netoptim/optscaling_oracle.hpp>  // for OptScalingOracle
+#include <random>                          // for mt19937
+#include <string>                          // for string, to_string
+#include <utility>                         // for pair
+#include <valarray>                        // for valarray
+#include <vector>                          // for vector
+
+/**
+ * @file bench_optimal_scaling.cpp
+ * @brief Compare optimal_scaling() with OptScalingOracle + ellipsoid method
+ *
+ * Every matrix has a symmetric sparsity pattern: a ring through all rows
+ * (so the graph is strongly connected) plus random off-diagonal pairs, with
+ * log-scale entries drawn uniformly. The gap pi - psi reached by each path
+ * is printed once per size, next to the timings.
+ */
+
+namespace {
+
+    using Entry = std::pair<double, double>;  // (a_ij, a_ji) in log scale
+    using Vec = std::valarray<double>;
+
+    auto create_random_matrix(uint32_t num_nodes, uint32_t num_pairs) -> CsrGraph<Entry> {
+        auto gen = std::mt19937{2024};
+        auto node = std::uniform_int_distribution<uint32_t>{0, num_nodes - 1};
+        auto value = std::uniform_real_distribution<double>{-10.0, 10.0};
+        auto ends = std::vector<std::pair<uint32_t, uint32_t>>{};
+        auto payloads = std::vector<Entry>{};
+        auto add = [&](uint32_t i, uint32_t j) {
+            const auto aij = value(gen);
+            const auto aji = value(gen);
+            ends.emplace_back(i, j);
+            payloads.emplace_back(aij, aji);
+            ends.emplace_back(j, i);
+            payloads.emplace_back(aji, aij);
+        };
+        for (auto utx = 0U; utx != num_nodes; ++utx) {
+            add(utx, (utx + 1) % num_nodes);
+        }
+        for (auto idx = num_nodes; idx < num_pairs; ++idx) {
+            add(node(gen), node(gen));
+        }
+        return {num_nodes, ends, std::move(payloads)};
+    }
+
+    const auto get_cost = [](const Entry& edge) -> Entry { return edge; };
+
+    /** @brief Optimal scaling through the oracle and the ellipsoid method */
+    auto ellipsoid_scaling(const CsrGraph<Entry>& gra) -> double {
+        auto a_min = std::numeric_limits<double>::infinity();
+        auto a_max = -std::numeric_limits<double>::infinity();
+        for (const auto& [aij, aji] : gra.edges()) {
+            a_min = std::min({a_min, aij, aji});
+            a_max = std::max({a_max, aij, aji});
+        }
+        auto dist = std::vector<double>(gra.num_nodes(), 0.0);
+        auto omega = OptScalingOracle(gra, dist, get_cost);
+        auto ellip = Ell<Vec>(1.5 * (a_max - a_min), Vec{a_max, a_min});
+        auto gamma = std::numeric_limits<double>::max();
+        cutting_plane_optim(omega, ellip, gamma);
+        return gamma;
+    }
+
+    /** @brief Optimal scaling solved directly */
+    auto direct_scaling(const CsrGraph<Entry>& gra) -> double {
+        auto dist = std::vector<double>(gra.num_nodes(), 0.0);
+        const auto [pi, psi] = optimal_scaling(gra, get_cost, dist);
+        return pi - psi;
+    }
+
+}  // namespace
+
+auto main() -> int {
+    const auto sizes = std::vector<std::pair<uint32_t, uint32_t>>{
+        {1000, 3000},
+        {10000, 30000},
+        {100000, 300000},
+    };
+
+    for (const auto& [num_nodes, num_pairs] : sizes) {
+        const auto gra = create_random_matrix(num_nodes, num_pairs);
+        std::printf("n=%u: gap ellipsoid %.6f, direct %.6f\n", num_nodes, ellipsoid_scaling(gra),
+                    direct_scaling(gra));
+
+        auto bench = ankerl::nanobench::Bench()
+                         .title("optimal scaling n=" + std::to_string(num_nodes))
+                         .relative(true)
+                         .minEpochIterations(num_nodes > 10000 ? 1 : 3);
+        bench.run("ellipsoid + oracle", [&] {
+            ankerl::nanobench::doNotOptimizeAway(ellipsoid_scaling(gra));
+        });
+        bench.run("optimal_scaling", [&] {
+            ankerl::nanobench::doNotOptimizeAway(direct_scaling(gra));
+        });
+    }
+    return 0;
+}
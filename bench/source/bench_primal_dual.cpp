@@ -0,0 +1,156 @@
+// -*- coding: utf-8 -*-
+#include <nanobench.h>  // for Bench, doNotOptimizeAway
+
+#include <algorithm>                          // for max
+#include <cassert>                            // for assert
+#include <cstdint>                            // for uint32_t
+#include <netoptim/dynamic_vertex_cover.hpp>  // for DynamicVertexCover
+#include <netoptim/primal_dual.hpp>           // for min_maximal_independant_set_pd
+#include <netoptim/primal_dual_parallel.hpp>  // for min_maximal_independant_set_pd_parallel
+#include <random>                             // for mt19937
+#include <string>                             // for string, to_string
+#include <thread>                             // for hardware_concurrency
+#include <utility>                            // for pair
+#include <vector>                             // for vector
+
+/**
+ * @file bench_primal_dual.cpp
+ * @brief Thread scaling of the parallel primal-dual algorithms
+ *
+ * A random graph with one million vertices and five million edges, random
+ * integer weights. Each algorithm is timed with 1, 2, 4, ... threads up to
+ * the hardware concurrency, relative to the sequential version. The last
+ * benchmark compares rerunning the cover after 5000 edge changes with
+ * updating a DynamicVertexCover.
+ */
+
+namespace {
+
+    struct Edge : std::pair<uint32_t, uint32_t> {
+        using std::pair<uint32_t, uint32_t>::pair;
+        [[nodiscard]] auto end_points() const { return *this; }
+    };
+
+    /** @brief Undirected graph: node ids, neighbor lists and an edge list */
+    class Graph {
+      public:
+        struct NodeIter {
+            uint32_t node;
+            auto operator++() -> NodeIter& {
+                ++node;
+                return *this;
+            }
+            auto operator*() const -> uint32_t { return node; }
+            auto operator!=(const NodeIter& other) const -> bool { return node != other.node; }
+        };
+
+        Graph(uint32_t num_nodes, std::vector<Edge> edges)
+            : _edges(std::move(edges)), _adj(num_nodes) {
+            for (const auto& [utx, vtx] : _edges) {
+                _adj[utx].push_back(vtx);
+                _adj[vtx].push_back(utx);
+            }
+        }
+
+        [[nodiscard]] auto begin() const { return NodeIter{0}; }
+        [[nodiscard]] auto end() const { return NodeIter{static_cast<uint32_t>(_adj.size())}; }
+        [[nodiscard]] auto operator[](uint32_t utx) const -> const std::vector<uint32_t>& {
+            return _adj[utx];
+        }
+        [[nodiscard]] auto edges() const -> const std::vector<Edge>& { return _edges; }
+
+      private:
+        std::vector<Edge> _edges;
+        std::vector<std::vector<uint32_t>> _adj;
+    };
+
+    auto create_random_graph(uint32_t num_nodes, uint32_t num_edges) -> Graph {
+        auto gen = std::mt19937{2024};
+        auto node = std::uniform_int_distribution<uint32_t>{0, num_nodes - 1};
+        auto edges = std::vector<Edge>{};
+        edges.reserve(num_edges);
+        for (auto idx = 0U; idx != num_edges; ++idx) {
+            edges.emplace_back(node(gen), node(gen));
+        }
+        return {num_nodes, std::move(edges)};
+    }
+
+}  // namespace
+
+auto main() -> int {
+    constexpr auto num_nodes = 1000000U;
+    const auto gra = create_random_graph(num_nodes, 5 * num_nodes);
+    auto gen = std::mt19937{7};
+    auto value = std::uniform_int_distribution<int>{1, 1000};
+    auto weight = std::vector<int>(num_nodes);
+    for (auto& wt : weight) {
+        wt = value(gen);
+    }
+    auto thread_counts = std::vector<size_t>{};
+    for (auto count = size_t(1); count <= std::max(1U, std::thread::hardware_concurrency());
+         count *= 2) {
+        thread_counts.push_back(count);
+    }
+
+    auto mis = ankerl::nanobench::Bench()
+                   .title("min maximal independent set n=1M m=5M")
+                   .relative(true)
+                   .minEpochIterations(1);
+    mis.run("sequential", [&] {
+        auto indset = std::vector<bool>(num_nodes, false);
+        auto dep = std::vector<bool>(num_nodes, false);
+        ankerl::nanobench::doNotOptimizeAway(
+            min_maximal_independant_set_pd(gra, indset, dep, weight));
+    });
+    for (const auto count : thread_counts) {
+        mis.run("parallel " + std::to_string(count) + " threads", [&] {
+            auto indset = std::vector<bool>(num_nodes, false);
+            auto dep = std::vector<bool>(num_nodes, false);
+            ankerl::nanobench::doNotOptimizeAway(
+                min_maximal_independant_set_pd_parallel(gra, indset, dep, weight, count));
+        });
+    }
+
+    auto cover = ankerl::nanobench::Bench()
+                     .title("min vertex cover n=1M m=5M")
+                     .relative(true)
+                     .minEpochIterations(1);
+    cover.run("sequential", [&] {
+        auto covered = std::vector<bool>(num_nodes, false);
+        ankerl::nanobench::doNotOptimizeAway(min_vertex_cover_pd(gra, covered, weight));
+    });
+    for (const auto count : thread_counts) {
+        cover.run("parallel " + std::to_string(count) + " threads", [&] {
+            auto covered = std::vector<bool>(num_nodes, false);
+            ankerl::nanobench::doNotOptimizeAway(
+                min_vertex_cover_pd_parallel(gra, covered, weight, count).primal);
+        });
+    }
+
+    constexpr auto num_changes = 5000U;
+    auto dyn = DynamicVertexCover<int>(weight);
+    auto live = std::vector<std::pair<Edge, size_t>>{};
+    live.reserve(gra.edges().size());
+    for (const auto& edge : gra.edges()) {
+        live.emplace_back(edge, dyn.insert_edge(edge.first, edge.second));
+    }
+    auto node = std::uniform_int_distribution<uint32_t>{0, num_nodes - 1};
+    auto update = ankerl::nanobench::Bench()
+                      .title("vertex cover after 5000 edge changes, n=1M m=5M")
+                      .relative(true)
+                      .minEpochIterations(1);
+    update.run("rerun min_vertex_cover_pd", [&] {
+        auto covered = std::vector<bool>(num_nodes, false);
+        ankerl::nanobench::doNotOptimizeAway(min_vertex_cover_pd(gra, covered, weight));
+    });
+    update.run("DynamicVertexCover update", [&] {
+        for (auto idx = 0U; idx != num_changes; ++idx) {
+            const auto pos = std::uniform_int_distribution<size_t>{0, live.size() - 1}(gen);
+            dyn.remove_edge(live[pos].second);
+            const auto edge = Edge{node(gen), node(gen)};
+            live[pos] = {edge, dyn.insert_edge(edge.first, edge.second)};
+        }
+        ankerl::nanobench::doNotOptimizeAway(dyn.primal_cost());
+    });
+    return 0;
+}
@@ -0,0 +1,314 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <digraphx/neg_cycle.hpp>  // import _get_val
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @file csr_graph.hpp
+ * @brief Compressed sparse row (CSR) graph for the network solvers
+ *
+ * This module provides a compact, read-only directed graph with dense
+ * `uint32_t` node ids. The adjacency structure is stored in three
+ * contiguous arrays:
+ *
+ *     offsets[u] .. offsets[u + 1]   slots of the out-edges of node u
+ *     targets[k]                     head node of slot k
+ *     edge_ids[k]                    edge id of slot k
+ *
+ * and the edge payloads are stored in a fourth array indexed by edge id.
+ * Relaxing all edges is therefore a linear sweep over memory instead of a
+ * hash lookup plus a pointer chase per edge.
+ *
+ * The graph mimics the shape of `std::unordered_map<node, std::list<std::pair<node, Edge>>>`
+ * (iterating yields `(node, neighbors)` pairs, iterating the neighbors yields
+ * `(node, edge)` pairs), so `max_parametric`, `min_cycle_ratio`,
+ * `NetworkOracle` and `OptScalingOracle` accept it unchanged. A specialized
+ * `NegCycleFinder` (see csr_neg_cycle.hpp) runs Howard's method directly on
+ * the arrays.
+ */
+
+namespace {
+    template <typename T>
+    concept HasFirst = requires(const T& elem) { elem.first; };
+
+    /** @brief Node key of a graph or neighbor-list element (pair or bare key) */
+    template <typename Elem> auto _csr_key_of(const Elem& elem) {
+        if constexpr (HasFirst<Elem>) {
+            return static_cast<uint32_t>(elem.first);
+        } else {
+            return static_cast<uint32_t>(elem);
+        }
+    }
+}  // namespace
+
+/**
+ * @brief Compressed sparse row directed graph
+ *
+ * Node ids are dense in `[0, num_nodes())`. Edge ids are dense in
+ * `[0, num_edges())` and follow the order in which edges were given to the
+ * constructor, so callers can keep their own per-edge arrays (costs, times,
+ * ...) indexed by edge id. Within a node, out-edges keep their input order.
+ *
+ * @tparam Edge Type of the edge payload
+ */
+template <typename Edge> class CsrGraph {
+  public:
+    using key_type = uint32_t;
+    using node_t = uint32_t;
+    using edge_t = Edge;
+
+    /** @brief Lightweight view over the out-edges of one node */
+    class Neighbors {
+      public:
+        class iterator {
+          public:
+            using value_type = std::pair<uint32_t, const Edge&>;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+            iterator(const CsrGraph* gra, uint32_t pos) : _gra{gra}, _pos{pos} {}
+
+            auto operator*() const -> value_type {
+                return {this->_gra->_targets[this->_pos],
+                        this->_gra->_payloads[this->_gra->_edge_ids[this->_pos]]};
+            }
+            auto operator++() -> iterator& {
+                ++this->_pos;
+                return *this;
+            }
+            auto operator++(int) -> iterator {
+                auto old = *this;
+                ++this->_pos;
+                return old;
+            }
+            auto operator==(const iterator& other) const -> bool {
+                return this->_pos == other._pos;
+            }
+
+          private:
+            const CsrGraph* _gra{nullptr};
+            uint32_t _pos{0};
+        };
+
+        Neighbors(const CsrGraph* gra, uint32_t first, uint32_t last)
+            : _gra{gra}, _first{first}, _last{last} {}
+
+        auto begin() const -> iterator { return {this->_gra, this->_first}; }
+        auto end() const -> iterator { return {this->_gra, this->_last}; }
+        auto size() const -> size_t { return this->_last - this->_first; }
+        auto empty() const -> bool { return this->_first == this->_last; }
+
+      private:
+        const CsrGraph* _gra;
+        uint32_t _first;
+        uint32_t _last;
+    };
+
+    /** @brief Lightweight view of the payloads of a list of edge ids (e.g. a cycle) */
+    class EdgeIdView {
+      public:
+        class iterator {
+          public:
+            using value_type = Edge;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+            iterator(const CsrGraph* gra, const uint32_t* pos) : _gra{gra}, _pos{pos} {}
+
+            auto operator*() const -> const Edge& { return this->_gra->_payloads[*this->_pos]; }
+            auto operator++() -> iterator& {
+                ++this->_pos;
+                return *this;
+            }
+            auto operator++(int) -> iterator {
+                auto old = *this;
+                ++this->_pos;
+                return old;
+            }
+            auto operator==(const iterator& other) const -> bool {
+                return this->_pos == other._pos;
+            }
+
+          private:
+            const CsrGraph* _gra{nullptr};
+            const uint32_t* _pos{nullptr};
+        };
+
+        EdgeIdView(const CsrGraph* gra, std::span<const uint32_t> ids) : _gra{gra}, _ids{ids} {}
+
+        auto begin() const -> iterator { return {this->_gra, this->_ids.data()}; }
+        auto end() const -> iterator { return {this->_gra, this->_ids.data() + this->_ids.size()}; }
+        auto size() const -> size_t { return this->_ids.size(); }
+        auto empty() const -> bool { return this->_ids.empty(); }
+        /** @brief The underlying edge ids */
+        auto ids() const -> std::span<const uint32_t> { return this->_ids; }
+
+      private:
+        const CsrGraph* _gra;
+        std::span<const uint32_t> _ids;
+    };
+
+    /** @brief Iterator over `(node, neighbors)` pairs */
+    class iterator {
+      public:
+        using value_type = std::pair<uint32_t, Neighbors>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        iterator(const CsrGraph* gra, uint32_t node) : _gra{gra}, _node{node} {}
+
+        auto operator*() const -> value_type { return {this->_node, (*this->_gra)[this->_node]}; }
+        auto operator++() -> iterator& {
+            ++this->_node;
+            return *this;
+        }
+        auto operator++(int) -> iterator {
+            auto old = *this;
+            ++this->_node;
+            return old;
+        }
+        auto operator==(const iterator& other) const -> bool { return this->_node == other._node; }
+
+      private:
+        const CsrGraph* _gra{nullptr};
+        uint32_t _node{0};
+    };
+
+    CsrGraph() = default;
+
+    /** @brief Construct from an edge list
+     * @details Edge `i` goes from `ends[i].first` to `ends[i].second` and
+     * carries `payloads[i]`; its edge id is `i`. The adjacency arrays are
+     * built with a stable counting sort on the source node.
+     * @param[in] num_nodes number of nodes (all end points must be smaller)
+     * @param[in] ends (source, target) pair of every edge
+     * @param[in] payloads edge payload of every edge, same length as ends */
+    CsrGraph(uint32_t num_nodes, std::span<const std::pair<uint32_t, uint32_t>> ends,
+             std::vector<Edge> payloads)
+        : _offsets(num_nodes + 1, 0U),
+          _targets(ends.size()),
+          _edge_ids(ends.size()),
+          _payloads(std::move(payloads)) {
+        assert(this->_payloads.size() == ends.size());
+        for (const auto& [utx, vtx] : ends) {
+            assert(utx < num_nodes && vtx < num_nodes);
+            ++this->_offsets[utx + 1];
+        }
+        for (auto utx = 0U; utx != num_nodes; ++utx) {
+            this->_offsets[utx + 1] += this->_offsets[utx];
+        }
+        auto fill = std::vector<uint32_t>(this->_offsets.begin(), this->_offsets.end() - 1);
+        for (auto eid = 0U; eid != static_cast<uint32_t>(ends.size()); ++eid) {
+            const auto& [utx, vtx] = ends[eid];
+            const auto slot = fill[utx]++;
+            this->_targets[slot] = vtx;
+            this->_edge_ids[slot] = eid;
+        }
+    }
+
+    /** @brief Construct from CSR arrays (taken over, not copied)
+     * @details The out-edges of node `u` occupy the slots `offsets[u]` to
+     * `offsets[u + 1] - 1`; slot `k` goes to `targets[k]`, carries
+     * `payloads[k]` and has edge id `k`.
+     * @param[in] offsets slot range of every node, num_nodes + 1 entries
+     * @param[in] targets head node of every slot
+     * @param[in] payloads edge payload of every slot, same length as targets */
+    CsrGraph(std::vector<uint32_t> offsets, std::vector<uint32_t> targets,
+             std::vector<Edge> payloads)
+        : _offsets(std::move(offsets)),
+          _targets(std::move(targets)),
+          _edge_ids(this->_targets.size()),
+          _payloads(std::move(payloads)) {
+        assert(!this->_offsets.empty() && this->_offsets.back() == this->_targets.size());
+        assert(this->_payloads.size() == this->_targets.size());
+        std::iota(this->_edge_ids.begin(), this->_edge_ids.end(), 0U);
+    }
+
+    /** @brief Out-edges of node utx */
+    auto operator[](uint32_t utx) const -> Neighbors {
+        return {this, this->_offsets[utx], this->_offsets[utx + 1]};
+    }
+    auto at(uint32_t utx) const -> Neighbors { return (*this)[utx]; }
+
+    auto begin() const -> iterator { return {this, 0U}; }
+    auto end() const -> iterator { return {this, this->num_nodes()}; }
+
+    /** @brief Number of nodes (same as num_nodes(), mirrors the map interface) */
+    auto size() const -> size_t { return this->num_nodes(); }
+    auto num_nodes() const -> uint32_t {
+        return this->_offsets.empty() ? 0U : static_cast<uint32_t>(this->_offsets.size() - 1);
+    }
+    auto number_of_nodes() const -> uint32_t { return this->num_nodes(); }
+    auto num_edges() const -> uint32_t { return static_cast<uint32_t>(this->_targets.size()); }
+
+    /** @name Raw CSR arrays */
+    ///@{
+    auto offsets() const -> std::span<const uint32_t> { return this->_offsets; }
+    auto targets() const -> std::span<const uint32_t> { return this->_targets; }
+    auto edge_ids() const -> std::span<const uint32_t> { return this->_edge_ids; }
+    /** @brief Edge payloads indexed by edge id */
+    auto edges() const -> std::span<const Edge> { return this->_payloads; }
+    ///@}
+
+    /** @brief Payload of the edge with id eid */
+    auto edge(uint32_t eid) const -> const Edge& { return this->_payloads[eid]; }
+
+    /** @brief View of the payloads of the edges ids (no copy) */
+    auto edges_of(std::span<const uint32_t> ids) const -> EdgeIdView { return {this, ids}; }
+
+  private:
+    std::vector<uint32_t> _offsets{};
+    std::vector<uint32_t> _targets{};
+    std::vector<uint32_t> _edge_ids{};
+    std::vector<Edge> _payloads{};
+};
+
+/**
+ * @brief Convert an adjacency-map graph into a CsrGraph
+ *
+ * Accepts the graph shapes used throughout the library, e.g.
+ * `std::unordered_map<uint32_t, std::list<std::pair<uint32_t, Edge>>>`,
+ * `py::dict<uint32_t, py::dict<uint32_t, Edge>>` or an xnetwork graph
+ * adaptor. Node keys must be integral and are used directly as dense node
+ * ids, so a `std::vector` distance mapping indexed by key stays valid. Edge
+ * ids follow the iteration order of the input graph.
+ *
+ * @tparam Graph Type of the input graph
+ * @param[in] gra the graph to convert (iterated exactly once)
+ * @return CsrGraph holding a copy of every edge payload
+ */
+template <typename Graph> auto to_csr(const Graph& gra) {
+    using Elem = decltype(*std::declval<const Graph&>().begin());
+    using Nbrs = std::remove_cv_t<std::remove_reference_t<
+        decltype(_get_val(std::declval<Elem>(), std::declval<const Graph&>()))>>;
+    using NbrElem = decltype(*std::declval<const Nbrs&>().begin());
+    using Edge = std::remove_cv_t<std::remove_reference_t<
+        decltype(_get_val(std::declval<NbrElem>(), std::declval<const Nbrs&>()))>>;
+
+    auto ends = std::vector<std::pair<uint32_t, uint32_t>>{};
+    auto payloads = std::vector<Edge>{};
+    auto num_nodes = 0U;
+    for (auto&& elem : gra) {
+        const auto utx = _csr_key_of(elem);
+        num_nodes = std::max(num_nodes, utx + 1);
+        const auto& nbrs = _get_val(elem, gra);
+        for (auto&& nbr : nbrs) {
+            const auto vtx = _csr_key_of(nbr);
+            num_nodes = std::max(num_nodes, vtx + 1);
+            ends.emplace_back(utx, vtx);
+            payloads.push_back(_get_val(nbr, nbrs));
+        }
+    }
+    return CsrGraph<Edge>(num_nodes, ends, std::move(payloads));
+}
+
+// The NegCycleFinder specialization must be visible wherever CsrGraph is.
+#include "csr_neg_cycle.hpp"  // IWYU pragma: export
@@ -0,0 +1,262 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <digraphx/neg_cycle.hpp>  // import NegCycleFinder
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+
+/**
+ * @file csr_neg_cycle.hpp
+ * @brief Howard's negative cycle finder specialized for CsrGraph
+ *
+ * The generic `NegCycleFinder` keeps its policy (the predecessor of every
+ * node) in a hash map and copies the edge payload into it on every
+ * successful relaxation. For a CsrGraph the policy is two dense arrays
+ * (predecessor node and predecessor edge id) and a relaxation sweep reads
+ * the offsets/targets/edge-id arrays front to back.
+ *
+ * Besides the payload-based `howard(dist, get_weight)` interface shared
+ * with the generic finder, this specialization offers `howard_ids`, which
+ * takes the edge weight as a function of the edge id and reports the
+ * cycles as spans of edge ids into an internal arena.
+ *
+ * With warm_start(true) the policy found by one Howard run is kept as the
+ * starting policy of the next run. This pays off in parametric searches,
+ * where consecutive runs differ only by a small change of the ratio and
+ * the previous policy is almost always close to the new one. A kept policy
+ * may contain links that do not satisfy the new weights, and a cycle
+ * through such a link need not be negative. So in this mode a cycle with a
+ * link kept from an earlier run is checked before it is reported; if it is
+ * not negative any more, that link is dropped. A cycle whose links were all
+ * set by the current run is reported as it is, exactly as in a run from
+ * scratch. (Checking those as well is not robust with floating-point
+ * weights: a cycle whose sum rounds to a non-negative value may still keep
+ * relaxing, and the run would never end.)
+ *
+ * Both interfaces take an optional stop predicate. It is polled before each
+ * pass and every few thousand nodes inside a sweep; once it returns true the
+ * run ends early and reports no cycles.
+ */
+
+namespace {
+    /** @brief Default stop predicate of the CSR finder: never stop */
+    struct _NeverStop {
+        constexpr auto operator()() const -> bool { return false; }
+    };
+}  // namespace
+
+/**
+ * @brief Negative cycle finder (Howard's method) on a CsrGraph
+ *
+ * @tparam Edge Type of the edge payload
+ */
+template <typename Edge> class NegCycleFinder<CsrGraph<Edge>> {
+    using Graph = CsrGraph<Edge>;
+    using Cycle = std::vector<Edge>;
+    using CycleIds = std::span<const uint32_t>;
+
+    static constexpr auto NIL = ~uint32_t{0};
+
+    const Graph* _gra;
+    std::vector<uint32_t> _pred_node;  // policy: predecessor node
+    std::vector<uint32_t> _pred_edge;  // policy: edge id from the predecessor
+    std::vector<uint32_t> _visited;    // root of the policy walk that reached a node
+    std::vector<uint32_t> _stamp;      // run that set the policy link of a node
+    std::vector<uint32_t> _arena{};    // edge ids of the cycles found in the last pass
+    std::vector<size_t> _starts{};     // start of each cycle in _arena
+    std::vector<CycleIds> _cycles{};
+    bool _warm_start{false};
+    uint32_t _run{0};
+    size_t _relax_passes{0};
+
+  public:
+    /** @brief Construct a new negative cycle finder
+     * @details The policy graph has one predecessor per node, so its cycles
+     * are node-disjoint and hold at most num_nodes edges altogether. All
+     * buffers are sized for that up front: howard_ids() never allocates.
+     * @param[in] gra the CSR graph (must outlive the finder) */
+    explicit NegCycleFinder(const Graph& gra)
+        : _gra{&gra},
+          _pred_node(gra.num_nodes(), NIL),
+          _pred_edge(gra.num_nodes(), NIL),
+          _visited(gra.num_nodes(), NIL),
+          _stamp(gra.num_nodes(), 0U) {
+        this->_arena.reserve(gra.num_nodes());
+        this->_starts.reserve(gra.num_nodes());
+        this->_cycles.reserve(gra.num_nodes());
+    }
+
+    /** @brief Find negative cycles, reported as edge payloads
+     * @details Same contract as the generic `NegCycleFinder::howard`: the
+     * policy is reset (unless warm_start is enabled), then relaxation passes
+     * run until the policy graph contains negative cycles (all of them are
+     * returned) or nothing changes.
+     * @param[in,out] dist distance mapping indexed by node id
+     * @param[in] get_weight edge payload -> weight
+     * @param[in] stop optional predicate; the run ends early once it returns true
+     * @return the negative cycles found (empty if there are none) */
+    template <typename Mapping, typename Callable, typename StopFn = _NeverStop>
+    auto howard(Mapping& dist, Callable&& get_weight, StopFn&& stop = {}) -> std::vector<Cycle> {
+        const auto& gra = *this->_gra;
+        auto cycles = std::vector<Cycle>{};
+        for (const auto& ids : this->howard_ids(
+                 dist, [&gra, &get_weight](uint32_t eid) { return get_weight(gra.edge(eid)); },
+                 stop)) {
+            auto& cycle = cycles.emplace_back();
+            cycle.reserve(ids.size());
+            for (const auto eid : ids) {
+                cycle.push_back(gra.edge(eid));
+            }
+        }
+        return cycles;
+    }
+
+    /** @brief Find negative cycles, reported as edge ids
+     * @param[in,out] dist distance mapping indexed by node id
+     * @param[in] weight_of edge id -> weight
+     * @param[in] stop optional predicate; the run ends early once it returns true
+     * @return the negative cycles found as spans of edge ids; they stay valid
+     *         until the next call */
+    template <typename Mapping, typename WeightFn, typename StopFn = _NeverStop>
+    auto howard_ids(Mapping& dist, WeightFn&& weight_of, StopFn&& stop = {})
+        -> std::span<const CycleIds> {
+        if (!this->_warm_start) {
+            std::fill(this->_pred_node.begin(), this->_pred_node.end(), NIL);
+        }
+        this->_cycles.clear();
+        ++this->_run;
+        while (this->_cycles.empty() && !stop() && this->_relax(dist, weight_of, stop)) {
+            ++this->_relax_passes;
+            this->_find_cycles(weight_of);
+        }
+        return this->_cycles;
+    }
+
+    /** @brief Switch to another graph, keeping the buffers
+     * @details The policy is reset and the buffers are resized to gra; they
+     * only reallocate if gra has more nodes than any graph seen before.
+     * @param[in] gra the CSR graph (must outlive the finder) */
+    auto rebind(const Graph& gra) -> void {
+        const auto num_nodes = gra.num_nodes();
+        this->_gra = &gra;
+        this->_pred_node.assign(num_nodes, NIL);
+        this->_pred_edge.assign(num_nodes, NIL);
+        this->_visited.assign(num_nodes, NIL);
+        this->_stamp.assign(num_nodes, 0U);
+        this->_arena.reserve(num_nodes);
+        this->_starts.reserve(num_nodes);
+        this->_cycles.reserve(num_nodes);
+        this->_run = 0;
+    }
+
+    /** @brief Keep the policy of the previous run as the starting policy
+     * @param[in] enable true to reuse the policy, false to reset it per run */
+    auto warm_start(bool enable) -> void { this->_warm_start = enable; }
+
+    /** @brief Forget the kept policy (the next run starts from scratch) */
+    auto reset_policy() -> void {
+        std::fill(this->_pred_node.begin(), this->_pred_node.end(), NIL);
+    }
+
+    /** @brief Number of relaxation passes (that changed a distance) so far */
+    auto relax_passes() const -> size_t { return this->_relax_passes; }
+
+  private:
+    /** @brief One Bellman-Ford sweep over all edges in CSR order
+     * @return true if any distance was improved (false if stopped) */
+    template <typename Mapping, typename WeightFn, typename StopFn>
+    auto _relax(Mapping& dist, WeightFn& weight_of, StopFn& stop) -> bool {
+        constexpr auto poll_mask = 0xFFFU;  // poll stop() every 4096 nodes
+        const auto offsets = this->_gra->offsets();
+        const auto targets = this->_gra->targets();
+        const auto edge_ids = this->_gra->edge_ids();
+        auto changed = false;
+        for (auto utx = 0U; utx != this->_gra->num_nodes(); ++utx) {
+            if constexpr (!std::is_same_v<std::remove_cvref_t<StopFn>, _NeverStop>) {
+                if ((utx & poll_mask) == poll_mask && stop()) {
+                    return false;
+                }
+            }
+            for (auto slot = offsets[utx]; slot != offsets[utx + 1]; ++slot) {
+                const auto vtx = targets[slot];
+                const auto eid = edge_ids[slot];
+                auto distance = dist[utx] + weight_of(eid);
+                if (dist[vtx] > distance) {
+                    dist[vtx] = std::move(distance);
+                    this->_pred_node[vtx] = utx;
+                    this->_pred_edge[vtx] = eid;
+                    this->_stamp[vtx] = this->_run;
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+
+    /** @brief Collect every (negative) cycle of the current policy graph into the arena */
+    template <typename WeightFn> auto _find_cycles(WeightFn& weight_of) -> void {
+        std::fill(this->_visited.begin(), this->_visited.end(), NIL);
+        this->_arena.clear();
+        this->_starts.clear();
+        for (auto root = 0U; root != this->_gra->num_nodes(); ++root) {
+            if (this->_visited[root] != NIL) {
+                continue;
+            }
+            auto utx = root;
+            while (true) {
+                this->_visited[utx] = root;
+                utx = this->_pred_node[utx];
+                if (utx == NIL) {
+                    break;
+                }
+                if (this->_visited[utx] != NIL) {
+                    if (this->_visited[utx] == root) {
+                        this->_collect(utx, weight_of);
+                    }
+                    break;
+                }
+            }
+        }
+        for (auto idx = 0U; idx != this->_starts.size(); ++idx) {
+            const auto last = idx + 1 == this->_starts.size() ? this->_arena.size()
+                                                               : this->_starts[idx + 1];
+            this->_cycles.emplace_back(this->_arena.data() + this->_starts[idx],
+                                       last - this->_starts[idx]);
+        }
+    }
+
+    /** @brief Append the policy cycle through handle to the arena
+     * @details Links set by the current run only form negative cycles. A
+     * cycle through a link kept from an earlier run (warm start) may be
+     * stale; if so, it is dropped and opened at that link. */
+    template <typename WeightFn> auto _collect(uint32_t handle, WeightFn& weight_of) -> void {
+        const auto start = this->_arena.size();
+        auto kept = NIL;  // a node whose link was set by an earlier run
+        auto vtx = handle;
+        do {
+            this->_arena.push_back(this->_pred_edge[vtx]);
+            if (this->_stamp[vtx] != this->_run) {
+                kept = vtx;
+            }
+            vtx = this->_pred_node[vtx];
+        } while (vtx != handle);
+        if (kept != NIL) {
+            auto total = weight_of(this->_arena[start]);
+            for (auto idx = start + 1; idx != this->_arena.size(); ++idx) {
+                total += weight_of(this->_arena[idx]);
+            }
+            if (!(total < decltype(total)(0))) {
+                this->_arena.resize(start);
+                this->_pred_node[kept] = NIL;
+                return;
+            }
+        }
+        this->_starts.push_back(start);
+    }
+};
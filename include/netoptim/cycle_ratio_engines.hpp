@@ -0,0 +1,460 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"           // import CsrGraph
+#include "min_cycle_ratio.hpp"     // import min_cycle_ratio_soa
+#include "parametric_weights.hpp"  // import ParametricWeights
+
+/**
+ * @file cycle_ratio_engines.hpp
+ * @brief Alternative engines for the minimum cycle ratio problem
+ *
+ * min_cycle_ratio() is a parametric search driven by Howard's negative
+ * cycle detection. Other classical algorithms solve the same problem and
+ * suit other graph shapes:
+ *
+ * - Karp: O(nm) dynamic program over walk lengths (O(n^2) memory). Exact
+ *   and predictable on small dense graphs. It computes a minimum *mean*
+ *   cycle, so it applies when every edge has the same time.
+ * - Young-Tarjan-Orlin (YTO): parametric shortest path tree, raising the
+ *   ratio from below and pivoting one tree edge at a time until a cycle
+ *   closes. Works well on huge sparse graphs. Requires positive times.
+ * - Lawler: bisection on the ratio with a negative cycle test per probe,
+ *   tightening the upper end with the ratio of every cycle found. Stops at
+ *   a relative tolerance, which suits floating-point ratios. Requires
+ *   positive times.
+ *
+ * All engines take a CsrGraph, share the signature of min_cycle_ratio()
+ * (plus a CycleRatioEngine selector) and return the same result: r0 is
+ * lowered to the minimum ratio if a cycle beats it, and the critical
+ * cycle is returned (empty otherwise). The Howard engine is
+ * min_cycle_ratio_soa(); when the precondition of another engine does not
+ * hold, the Howard engine is used instead.
+ */
+
+/** @brief Algorithm used by min_cycle_ratio(..., CycleRatioEngine, ...) */
+enum class CycleRatioEngine { Howard, Karp, YoungTarjanOrlin, Lawler };
+
+namespace {
+    template <typename T> auto _all_positive(std::span<const T> values) -> bool {
+        return std::all_of(values.begin(), values.end(), [](const T& val) { return val > T(0); });
+    }
+
+    template <typename Edge> auto _materialize(const CsrGraph<Edge>& gra,
+                                               const std::vector<uint32_t>& ids)
+        -> std::vector<Edge> {
+        auto cycle = std::vector<Edge>{};
+        cycle.reserve(ids.size());
+        for (const auto eid : ids) {
+            cycle.push_back(gra.edge(eid));
+        }
+        return cycle;
+    }
+}  // namespace
+
+/**
+ * @brief Minimum cycle ratio by Karp's minimum mean cycle algorithm
+ *
+ * D_k(v) is the minimum cost of a walk with exactly k edges ending at v
+ * (starting anywhere). The minimum mean cycle value is
+ * @f[
+ *     \lambda^* = \min_v \max_{0 \le k < n} \frac{D_n(v) - D_k(v)}{n - k}
+ * @f]
+ * and any cycle on the n-edge walk to the minimizing v attains it. With a
+ * uniform time t per edge, the minimum cycle ratio is @f$\lambda^* / t@f$.
+ *
+ * @return empty cycle if the graph is acyclic or the ratio does not beat r0
+ */
+template <typename Edge, typename T, typename Fn1, typename Fn2>
+auto karp_min_cycle_ratio(const CsrGraph<Edge>& gra, T& r0, Fn1&& get_cost, Fn2&& get_time)
+    -> std::vector<Edge> {
+    constexpr auto NIL = ~uint32_t{0};
+    const auto weights = ParametricWeights<T>(gra.edges(), get_cost, get_time);
+    const auto costs = weights.costs();
+    const auto n = gra.num_nodes();
+    if (n == 0 || gra.num_edges() == 0) {
+        return {};
+    }
+    const auto offsets = gra.offsets();
+    const auto targets = gra.targets();
+    const auto edge_ids = gra.edge_ids();
+
+    // level k occupies [k * n, (k + 1) * n); pred holds the last edge of the walk
+    auto walk = std::vector<T>(size_t(n + 1) * n, T(0));
+    auto pred = std::vector<uint32_t>(size_t(n + 1) * n, NIL);
+    auto reached = std::vector<char>(size_t(n + 1) * n, 0);
+    auto source = std::vector<uint32_t>(gra.num_edges());
+    std::fill_n(reached.begin(), n, char(1));
+    for (auto utx = 0U; utx != n; ++utx) {
+        for (auto slot = offsets[utx]; slot != offsets[utx + 1]; ++slot) {
+            source[edge_ids[slot]] = utx;
+        }
+    }
+    for (auto k = size_t(1); k <= n; ++k) {
+        const auto prev = (k - 1) * n;
+        const auto curr = k * n;
+        for (auto utx = 0U; utx != n; ++utx) {
+            if (!reached[prev + utx]) {
+                continue;
+            }
+            for (auto slot = offsets[utx]; slot != offsets[utx + 1]; ++slot) {
+                const auto vtx = targets[slot];
+                const auto eid = edge_ids[slot];
+                auto distance = walk[prev + utx] + costs[eid];
+                if (!reached[curr + vtx] || walk[curr + vtx] > distance) {
+                    walk[curr + vtx] = std::move(distance);
+                    pred[curr + vtx] = eid;
+                    reached[curr + vtx] = 1;
+                }
+            }
+        }
+    }
+
+    auto best = T(0);
+    auto best_vtx = NIL;
+    const auto last = size_t(n) * n;
+    for (auto vtx = 0U; vtx != n; ++vtx) {
+        if (!reached[last + vtx]) {
+            continue;
+        }
+        auto worst = T(0);
+        auto has_worst = false;
+        for (auto k = size_t(0); k != n; ++k) {
+            if (!reached[k * n + vtx]) {
+                continue;
+            }
+            auto mean = (walk[last + vtx] - walk[k * n + vtx]) / T(n - k);
+            if (!has_worst || mean > worst) {
+                worst = std::move(mean);
+                has_worst = true;
+            }
+        }
+        if (best_vtx == NIL || best > worst) {
+            best = std::move(worst);
+            best_vtx = vtx;
+        }
+    }
+    if (best_vtx == NIL) {
+        return {};  // no walk with n edges: acyclic
+    }
+
+    // walk back n edges from best_vtx; the first repeated node closes a cycle
+    auto first_seen = std::vector<uint32_t>(n, NIL);
+    auto path = std::vector<uint32_t>{};  // edge ids, from the end of the walk backwards
+    auto vtx = best_vtx;
+    auto cycle = std::vector<uint32_t>{};
+    for (auto k = size_t(n); k > 0; --k) {
+        if (first_seen[vtx] != NIL) {
+            cycle.assign(path.begin() + first_seen[vtx], path.end());
+            break;
+        }
+        first_seen[vtx] = static_cast<uint32_t>(path.size());
+        const auto eid = pred[k * n + vtx];
+        path.push_back(eid);
+        vtx = source[eid];
+    }
+    if (cycle.empty()) {
+        cycle.assign(path.begin() + first_seen[vtx], path.end());
+    }
+
+    auto ratio = weights.ratio(cycle);
+    if (!(r0 > ratio)) {
+        return {};
+    }
+    r0 = std::move(ratio);
+    return _materialize(gra, cycle);
+}
+
+/**
+ * @brief Minimum cycle ratio by the Young-Tarjan-Orlin parametric shortest path
+ *
+ * Keeps a shortest path tree (rooted at a virtual source linked to every
+ * node) for the weights cost - r * time while r grows from -infinity. The
+ * distance of every node is linear in r, a(v) - r * b(v), so each non-tree
+ * edge (u, v) becomes tight at
+ * @f[
+ *     r_{uv} = \frac{a(u) + c_{uv} - a(v)}{b(u) + t_{uv} - b(v)}
+ * @f]
+ * The smallest r_uv is taken from a heap: if v is an ancestor of u, the
+ * edge closes a cycle whose ratio is r_uv, the minimum; otherwise u becomes
+ * the parent of v and the keys of the edges around v's subtree change.
+ * The heap uses lazy deletion instead of Fibonacci-heap decrease-key.
+ *
+ * @return empty cycle if the graph is acyclic or the ratio does not beat r0
+ */
+template <typename Edge, typename T, typename Fn1, typename Fn2>
+auto yto_min_cycle_ratio(const CsrGraph<Edge>& gra, T& r0, Fn1&& get_cost, Fn2&& get_time)
+    -> std::vector<Edge> {
+    constexpr auto NIL = ~uint32_t{0};
+    const auto weights = ParametricWeights<T>(gra.edges(), get_cost, get_time);
+    const auto costs = weights.costs();
+    const auto times = weights.times();
+    const auto n = gra.num_nodes();
+    const auto m = gra.num_edges();
+    const auto offsets = gra.offsets();
+    const auto targets = gra.targets();
+    const auto edge_ids = gra.edge_ids();
+
+    auto source = std::vector<uint32_t>(m);
+    auto target = std::vector<uint32_t>(m);
+    auto in_offsets = std::vector<uint32_t>(n + 1, 0U);
+    for (auto utx = 0U; utx != n; ++utx) {
+        for (auto slot = offsets[utx]; slot != offsets[utx + 1]; ++slot) {
+            source[edge_ids[slot]] = utx;
+            target[edge_ids[slot]] = targets[slot];
+            ++in_offsets[targets[slot] + 1];
+        }
+    }
+    for (auto vtx = 0U; vtx != n; ++vtx) {
+        in_offsets[vtx + 1] += in_offsets[vtx];
+    }
+    auto in_edges = std::vector<uint32_t>(m);
+    {
+        auto fill = std::vector<uint32_t>(in_offsets.begin(), in_offsets.end() - 1);
+        for (auto eid = 0U; eid != m; ++eid) {
+            in_edges[fill[target[eid]]++] = eid;
+        }
+    }
+
+    // tree: parent edge (NIL = child of the virtual source) and child lists
+    auto parent_edge = std::vector<uint32_t>(n, NIL);
+    auto first_child = std::vector<uint32_t>(n, NIL);
+    auto next_sibling = std::vector<uint32_t>(n, NIL);
+    auto prev_sibling = std::vector<uint32_t>(n, NIL);
+    auto dist_a = std::vector<T>(n, T(0));
+    auto dist_b = std::vector<T>(n, T(0));
+    auto version = std::vector<uint32_t>(m, 0U);
+
+    using Key = std::pair<T, std::pair<uint32_t, uint32_t>>;  // (r, (edge id, version))
+    auto heap = std::priority_queue<Key, std::vector<Key>, std::greater<>>{};
+    auto push_key = [&](uint32_t eid) {
+        ++version[eid];
+        const auto utx = source[eid];
+        const auto vtx = target[eid];
+        if (parent_edge[vtx] == eid) {
+            return;  // tree edge
+        }
+        auto slope = dist_b[utx] + times[eid] - dist_b[vtx];
+        if (slope > T(0)) {
+            heap.emplace((dist_a[utx] + costs[eid] - dist_a[vtx]) / slope,
+                         std::pair{eid, version[eid]});
+        }
+    };
+    auto parent_of = [&](uint32_t vtx) {
+        return parent_edge[vtx] == NIL ? NIL : source[parent_edge[vtx]];
+    };
+
+    for (auto eid = 0U; eid != m; ++eid) {
+        push_key(eid);
+    }
+
+    auto subtree = std::vector<uint32_t>{};
+    while (!heap.empty()) {
+        auto [r, handle] = heap.top();
+        heap.pop();
+        const auto [eid, ver] = handle;
+        if (ver != version[eid]) {
+            continue;  // stale key
+        }
+        if (!(r0 > r)) {
+            return {};  // no cycle beats r0
+        }
+        const auto utx = source[eid];
+        const auto vtx = target[eid];
+
+        // does the edge close a cycle, i.e. is vtx an ancestor of utx (or utx itself)?
+        auto anc = utx;
+        while (anc != NIL && anc != vtx) {
+            anc = parent_of(anc);
+        }
+        if (anc == vtx) {
+            auto cycle = std::vector<uint32_t>{eid};
+            for (auto wtx = utx; wtx != vtx; wtx = source[parent_edge[wtx]]) {
+                cycle.push_back(parent_edge[wtx]);
+            }
+            r0 = weights.ratio(cycle);
+            return _materialize(gra, cycle);
+        }
+
+        // pivot: utx becomes the parent of vtx
+        const auto old_parent = parent_of(vtx);
+        if (old_parent != NIL) {
+            if (prev_sibling[vtx] != NIL) {
+                next_sibling[prev_sibling[vtx]] = next_sibling[vtx];
+            } else {
+                first_child[old_parent] = next_sibling[vtx];
+            }
+            if (next_sibling[vtx] != NIL) {
+                prev_sibling[next_sibling[vtx]] = prev_sibling[vtx];
+            }
+        }
+        parent_edge[vtx] = eid;
+        prev_sibling[vtx] = NIL;
+        next_sibling[vtx] = first_child[utx];
+        if (first_child[utx] != NIL) {
+            prev_sibling[first_child[utx]] = vtx;
+        }
+        first_child[utx] = vtx;
+
+        const auto delta_a = dist_a[utx] + costs[eid] - dist_a[vtx];
+        const auto delta_b = dist_b[utx] + times[eid] - dist_b[vtx];
+        subtree.assign(1, vtx);
+        for (auto idx = size_t(0); idx != subtree.size(); ++idx) {
+            const auto wtx = subtree[idx];
+            dist_a[wtx] += delta_a;
+            dist_b[wtx] += delta_b;
+            for (auto child = first_child[wtx]; child != NIL; child = next_sibling[child]) {
+                subtree.push_back(child);
+            }
+        }
+        for (const auto wtx : subtree) {
+            for (auto slot = offsets[wtx]; slot != offsets[wtx + 1]; ++slot) {
+                push_key(edge_ids[slot]);
+            }
+            for (auto idx = in_offsets[wtx]; idx != in_offsets[wtx + 1]; ++idx) {
+                push_key(in_edges[idx]);
+            }
+        }
+    }
+    return {};  // acyclic
+}
+
+/**
+ * @brief Minimum cycle ratio by Lawler's bisection
+ *
+ * Keeps an interval [lo, hi] around the optimum: lo starts at the smallest
+ * edge ratio cost/time (a lower bound for any cycle when times are
+ * positive) and hi at the ratio of the first cycle that beats r0. Each
+ * probe r = (lo + hi) / 2 runs Howard's negative cycle test with the
+ * weights cost - r * time: a negative cycle lowers hi to its own ratio,
+ * otherwise lo rises to r. Stops when hi - lo is within a relative
+ * tolerance of 1e-12 or after max_iters probes.
+ *
+ * @return empty cycle if the graph is acyclic or the ratio does not beat r0
+ */
+template <typename Edge, typename T, typename Fn1, typename Fn2, typename Mapping>
+auto lawler_min_cycle_ratio(const CsrGraph<Edge>& gra, T& r0, Fn1&& get_cost, Fn2&& get_time,
+                            Mapping&& dist, size_t max_iters = 1000) -> std::vector<Edge> {
+    auto weights = ParametricWeights<T>(gra.edges(), get_cost, get_time);
+    auto get_weight = [&weights](uint32_t eid) -> const T& { return weights[eid]; };
+    auto ncf = NegCycleFinder<CsrGraph<Edge>>(gra);
+    ncf.warm_start(true);
+
+    auto c_opt = std::vector<uint32_t>{};
+    auto hi = r0;
+    // probe r: returns true (and lowers hi) if a cycle with ratio below r exists
+    auto probe = [&](const T& r) {
+        weights.update(r);
+        auto found = false;
+        for (const auto& ci : ncf.howard_ids(dist, get_weight)) {
+            auto ri = weights.ratio(ci);
+            found = found || r > ri;  // not a rounding-level zero cycle
+            if (hi > ri) {
+                hi = std::move(ri);
+                c_opt.assign(ci.begin(), ci.end());
+            }
+        }
+        return found;
+    };
+
+    if (gra.num_edges() == 0 || !probe(hi)) {
+        return {};
+    }
+    const auto costs = weights.costs();
+    const auto times = weights.times();
+    auto lo = costs[0] / times[0];
+    for (auto eid = size_t(1); eid != costs.size(); ++eid) {
+        lo = std::min(lo, costs[eid] / times[eid]);
+    }
+    const auto tol = T(1e-12);
+    for (auto niter = size_t(1); niter < max_iters; ++niter) {
+        auto scale = std::max(std::abs(lo), std::abs(hi));
+        if (!(hi - lo > tol * std::max(T(1), scale))) {
+            break;
+        }
+        const auto mid = (lo + hi) / T(2);
+        if (!probe(mid)) {
+            lo = mid;
+        }
+    }
+    r0 = hi;
+    return _materialize(gra, c_opt);
+}
+
+/**
+ * @brief Engine that min_cycle_ratio(..., engine, ...) actually runs
+ *
+ * Karp falls back to Howard unless all times are equal and positive; YTO
+ * and Lawler fall back to Howard unless all times are positive, and Lawler
+ * also unless T is a floating-point type.
+ *
+ * @tparam T Numeric type of the ratio
+ * @param[in] engine the requested algorithm
+ * @return CycleRatioEngine engine, or CycleRatioEngine::Howard if its
+ *         precondition does not hold
+ */
+template <typename T, typename Edge, typename Fn2>
+auto select_cycle_ratio_engine(const CsrGraph<Edge>& gra, Fn2&& get_time, CycleRatioEngine engine)
+    -> CycleRatioEngine {
+    if (engine == CycleRatioEngine::Howard
+        || (engine == CycleRatioEngine::Lawler && !std::is_floating_point_v<T>)) {
+        return CycleRatioEngine::Howard;
+    }
+    auto times = std::vector<T>{};
+    times.reserve(gra.num_edges());
+    for (const auto& edge : gra.edges()) {
+        times.push_back(T(get_time(edge)));
+    }
+    if (!_all_positive(std::span<const T>(times))) {
+        return CycleRatioEngine::Howard;
+    }
+    if (engine == CycleRatioEngine::Karp
+        && !std::all_of(times.begin(), times.end(),
+                        [&times](const T& val) { return val == times[0]; })) {
+        return CycleRatioEngine::Howard;
+    }
+    return engine;
+}
+
+/**
+ * @brief Solve the minimum cycle ratio problem with a selectable engine
+ *
+ * Same signature and result as min_cycle_ratio(), with the algorithm
+ * chosen at run time. Karp and YTO do not use dist. An engine whose
+ * precondition does not hold falls back to Howard (see
+ * select_cycle_ratio_engine()).
+ *
+ * @param[in] engine the algorithm to run
+ * @see min_cycle_ratio
+ */
+template <typename Edge, typename T, typename Fn1, typename Fn2, typename Mapping>
+auto min_cycle_ratio(const CsrGraph<Edge>& gra, T& r0, Fn1&& get_cost, Fn2&& get_time,
+                     Mapping&& dist, CycleRatioEngine engine, size_t max_iters = 1000)
+    -> std::vector<Edge> {
+    switch (select_cycle_ratio_engine<T>(gra, get_time, engine)) {
+        case CycleRatioEngine::Karp:
+            return karp_min_cycle_ratio(gra, r0, get_cost, get_time);
+        case CycleRatioEngine::YoungTarjanOrlin:
+            return yto_min_cycle_ratio(gra, r0, get_cost, get_time);
+        case CycleRatioEngine::Lawler:
+            if constexpr (std::is_floating_point_v<T>) {
+                return lawler_min_cycle_ratio(gra, r0, get_cost, get_time,
+                                              std::forward<Mapping>(dist), max_iters);
+            }
+            break;
+        case CycleRatioEngine::Howard:
+            break;
+    }
+    return min_cycle_ratio_soa(gra, r0, get_cost, get_time, std::forward<Mapping>(dist),
+                               max_iters);
+}
@@ -0,0 +1,157 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <vector>
+
+/**
+ * @file dense_bitset.hpp
+ * @brief Dense bitset for vertex flags (cover, dependent, ...)
+ *
+ * The primal-dual routines keep one flag per vertex. DenseBitset stores
+ * them in cache-line aligned 64-bit words and, unlike std::vector<bool>,
+ * exposes the words: two flags can be tested with one OR, a neighbor list
+ * marked a word at a time, the whole set counted with popcount, and bits
+ * set from several threads at once through std::atomic_ref on the word
+ * (fetch_or), without a byte per vertex.
+ *
+ * It can be passed wherever a `std::vector<bool>` cover or dependency
+ * mapping is accepted (`flags[v]` reads, `flags[v] = true` writes).
+ */
+
+/**
+ * @brief Fixed-size set of bits indexed by vertex id
+ */
+class DenseBitset {
+  public:
+    using word_type = uint64_t;
+    static constexpr size_t word_bits = 64;
+
+    /** @brief Writable reference to one bit (the result of operator[]) */
+    class reference {
+      public:
+        reference(word_type& word, word_type mask) : _word{word}, _mask{mask} {}
+        reference(const reference&) = default;
+
+        auto operator=(bool value) -> reference& {
+            this->_word = value ? (this->_word | this->_mask) : (this->_word & ~this->_mask);
+            return *this;
+        }
+        auto operator=(const reference& other) -> reference& { return *this = bool(other); }
+        operator bool() const { return (this->_word & this->_mask) != 0; }
+
+      private:
+        word_type& _word;
+        word_type _mask;
+    };
+
+    DenseBitset() = default;
+
+    /** @brief All bits cleared
+     * @param[in] num_bits number of bits (vertex ids 0 .. num_bits - 1) */
+    explicit DenseBitset(size_t num_bits)
+        : _words((num_bits + word_bits - 1) / word_bits, 0), _size{num_bits} {}
+
+    auto size() const -> size_t { return this->_size; }
+
+    auto operator[](size_t pos) const -> bool { return this->test(pos); }
+    auto operator[](size_t pos) -> reference {
+        return {this->_words[pos / word_bits], _mask(pos)};
+    }
+
+    auto test(size_t pos) const -> bool {
+        return ((this->_words[pos / word_bits] >> (pos % word_bits)) & 1U) != 0;
+    }
+    /** @brief True if bit lhs or bit rhs is set (two loads, one OR, no branch) */
+    auto test_any(size_t lhs, size_t rhs) const -> bool {
+        return (((this->_words[lhs / word_bits] >> (lhs % word_bits))
+                 | (this->_words[rhs / word_bits] >> (rhs % word_bits)))
+                & 1U)
+               != 0;
+    }
+    auto set(size_t pos) -> void { this->_words[pos / word_bits] |= _mask(pos); }
+    /** @brief Set the bit of every position in positions
+     * @details Consecutive positions that fall in the same word (as in a
+     * sorted neighbor list) are gathered in a register and ORed into the
+     * word with one store. */
+    template <typename Range> auto set_all(const Range& positions) -> void {
+        auto index = size_t(0);
+        auto mask = word_type(0);
+        for (auto&& pos : positions) {
+            const auto idx = static_cast<size_t>(pos) / word_bits;
+            if (idx != index) {
+                this->_words[index] |= mask;
+                index = idx;
+                mask = 0;
+            }
+            mask |= _mask(static_cast<size_t>(pos));
+        }
+        if (mask != 0) {
+            this->_words[index] |= mask;
+        }
+    }
+    auto reset(size_t pos) -> void { this->_words[pos / word_bits] &= ~_mask(pos); }
+    /** @brief Clear all bits */
+    auto reset() -> void { std::fill(this->_words.begin(), this->_words.end(), word_type(0)); }
+
+    /** @name Atomic access
+     * Relaxed atomic operations on the word holding the bit, for bitsets
+     * shared between threads. */
+    ///@{
+    auto test_atomic(size_t pos) const -> bool {
+        auto& word = const_cast<word_type&>(this->_words[pos / word_bits]);
+        return ((std::atomic_ref<word_type>(word).load(std::memory_order_relaxed)
+                 >> (pos % word_bits))
+                & 1U)
+               != 0;
+    }
+    /** @brief Set a bit; @return true if it was already set */
+    auto set_atomic(size_t pos) -> bool {
+        const auto mask = _mask(pos);
+        auto word = std::atomic_ref<word_type>(this->_words[pos / word_bits]);
+        return (word.fetch_or(mask, std::memory_order_relaxed) & mask) != 0;
+    }
+    ///@}
+
+    /** @brief Number of set bits (popcount over the words) */
+    auto count() const -> size_t {
+        auto total = size_t(0);
+        for (const auto word : this->_words) {
+            total += static_cast<size_t>(std::popcount(word));
+        }
+        return total;
+    }
+
+    /** @brief The underlying words; bits past size() are always zero */
+    auto words() const -> std::span<const word_type> { return this->_words; }
+
+  private:
+    /** @brief Allocator returning 64-byte (cache line) aligned storage */
+    template <typename T> struct _CacheAligned {
+        using value_type = T;
+        static constexpr auto alignment = std::align_val_t{64};
+
+        _CacheAligned() = default;
+        template <typename U> _CacheAligned(const _CacheAligned<U>& /*other*/) {}
+
+        auto allocate(size_t count) -> T* {
+            return static_cast<T*>(::operator new(count * sizeof(T), alignment));
+        }
+        auto deallocate(T* ptr, size_t /*count*/) -> void { ::operator delete(ptr, alignment); }
+
+        template <typename U> auto operator==(const _CacheAligned<U>& /*other*/) const -> bool {
+            return true;
+        }
+    };
+
+    static auto _mask(size_t pos) -> word_type { return word_type(1) << (pos % word_bits); }
+
+    std::vector<word_type, _CacheAligned<word_type>> _words{};
+    size_t _size{0};
+};
@@ -0,0 +1,212 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @file dynamic_vertex_cover.hpp
+ * @brief Primal-dual vertex cover maintained under edge insertions and deletions
+ *
+ * min_vertex_cover_pd() raises the dual y_e of each uncovered edge until one
+ * endpoint becomes tight (sum of the duals around it equals its weight) and
+ * takes the tight endpoints as the cover. Every cover vertex is paid for by
+ * its incident duals, hence primal <= 2 * dual <= 2 * OPT.
+ *
+ * DynamicVertexCover keeps that state -- the gap (remaining slack) of every
+ * vertex and the dual of every edge -- and repairs it locally:
+ *
+ * - inserting an edge that is already covered changes nothing; otherwise its
+ *   dual is raised exactly as in min_vertex_cover_pd(), O(1)
+ * - removing an edge returns its dual to both endpoints; an endpoint that is
+ *   no longer tight leaves the cover and the edges around it that became
+ *   uncovered are raised again, O(deg u + deg v)
+ *
+ * A sequence of insertions alone gives the same cover as running
+ * min_vertex_cover_pd() over the edges in that order.
+ */
+
+/**
+ * @brief Vertex cover with a 2-approximation certificate, updated per edge
+ *
+ * @tparam T Type of the vertex weights
+ */
+template <typename T> class DynamicVertexCover {
+  public:
+    using edge_id = size_t;
+
+    /**
+     * @brief Empty graph on weight.size() vertices
+     *
+     * @param[in] weight vertex weights (non-negative)
+     */
+    explicit DynamicVertexCover(std::vector<T> weight)
+        : _gap(weight),
+          _weight(std::move(weight)),
+          _cover(this->_weight.size(), false),
+          _incident(this->_weight.size()) {}
+
+    /**
+     * @brief Insert the edge (utx, vtx) and cover it if needed
+     *
+     * Parallel edges and self-loops are allowed; each insertion is a separate
+     * edge with its own id.
+     *
+     * @param[in] utx one endpoint
+     * @param[in] vtx the other endpoint
+     * @return edge_id handle for remove_edge() and dual()
+     */
+    auto insert_edge(uint32_t utx, uint32_t vtx) -> edge_id {
+        assert(utx < this->_weight.size() && vtx < this->_weight.size());
+        auto eid = edge_id{};
+        if (this->_free.empty()) {
+            eid = this->_edges.size();
+            this->_edges.emplace_back();
+        } else {
+            eid = this->_free.back();
+            this->_free.pop_back();
+        }
+        auto& edge = this->_edges[eid];
+        edge = _Edge{utx, vtx, this->_incident[utx].size(), 0, T(0), true};
+        this->_incident[utx].push_back(eid);
+        if (vtx != utx) {
+            edge.pos_v = this->_incident[vtx].size();
+            this->_incident[vtx].push_back(eid);
+        }
+        ++this->_num_edges;
+        this->_raise(eid);
+        return eid;
+    }
+
+    /**
+     * @brief Remove an edge and repair the cover around its endpoints
+     *
+     * @param[in] eid an id returned by insert_edge() and not yet removed
+     */
+    auto remove_edge(edge_id eid) -> void {
+        assert(eid < this->_edges.size() && this->_edges[eid].alive);
+        auto& edge = this->_edges[eid];
+        const auto utx = edge.utx;
+        const auto vtx = edge.vtx;
+        this->_unlink(utx, edge.pos_u);
+        if (vtx != utx) {
+            this->_unlink(vtx, edge.pos_v);
+        }
+        const auto dual = edge.dual;
+        edge.alive = false;
+        this->_free.push_back(eid);
+        --this->_num_edges;
+        if (dual == T(0)) {
+            return;  // nothing was paid through this edge
+        }
+
+        this->_dual_cost -= dual;
+        this->_loosen(utx, dual);
+        if (vtx != utx) {
+            this->_loosen(vtx, dual);
+        }
+        this->_repair(utx);
+        if (vtx != utx) {
+            this->_repair(vtx);
+        }
+    }
+
+    /** @brief True if vertex vtx is in the cover */
+    auto in_cover(uint32_t vtx) const -> bool { return this->_cover[vtx]; }
+
+    /** @brief The cover as a vertex -> bool mapping */
+    auto cover() const -> const std::vector<bool>& { return this->_cover; }
+
+    /** @brief Weight of vtx not yet paid for by the duals of its edges */
+    auto gap(uint32_t vtx) const -> T { return this->_gap[vtx]; }
+
+    /** @brief Dual value y_e of a live edge */
+    auto dual(edge_id eid) const -> T { return this->_edges[eid].dual; }
+
+    /** @brief Total weight of the cover */
+    auto primal_cost() const -> T { return this->_primal_cost; }
+
+    /** @brief Sum of the edge duals, a lower bound on the optimal cover */
+    auto dual_cost() const -> T { return this->_dual_cost; }
+
+    auto num_nodes() const -> size_t { return this->_weight.size(); }
+    auto num_edges() const -> size_t { return this->_num_edges; }
+
+  private:
+    struct _Edge {
+        uint32_t utx;
+        uint32_t vtx;
+        size_t pos_u;  ///< index in _incident[utx]
+        size_t pos_v;  ///< index in _incident[vtx] (unused for a self-loop)
+        T dual;
+        bool alive;
+    };
+
+    /** @brief Raise the dual of an uncovered edge by the smaller gap of its endpoints */
+    auto _raise(edge_id eid) -> void {
+        auto& edge = this->_edges[eid];
+        auto utx = edge.utx;
+        auto vtx = edge.vtx;
+        if (this->_cover[utx] || this->_cover[vtx]) {
+            return;
+        }
+        if (this->_gap[utx] < this->_gap[vtx]) {
+            std::swap(utx, vtx);
+        }
+        const auto dual = this->_gap[vtx];
+        edge.dual += dual;
+        this->_dual_cost += dual;
+        this->_cover[vtx] = true;
+        this->_primal_cost += this->_weight[vtx];
+        if (utx != vtx) {
+            this->_gap[utx] -= dual;
+        }
+        this->_gap[vtx] = T(0);
+    }
+
+    /** @brief Give back dual to vtx; it leaves the cover once it has slack */
+    auto _loosen(uint32_t vtx, const T& dual) -> void {
+        this->_gap[vtx] += dual;
+        if (this->_cover[vtx] && this->_gap[vtx] > T(0)) {
+            this->_cover[vtx] = false;
+            this->_primal_cost -= this->_weight[vtx];
+        }
+    }
+
+    /** @brief Cover again the edges around vtx left uncovered by _loosen() */
+    auto _repair(uint32_t vtx) -> void {
+        if (this->_cover[vtx]) {
+            return;
+        }
+        for (const auto eid : this->_incident[vtx]) {
+            this->_raise(eid);
+        }
+    }
+
+    /** @brief Swap-remove the entry at pos of vtx's incidence list */
+    auto _unlink(uint32_t vtx, size_t pos) -> void {
+        auto& incident = this->_incident[vtx];
+        const auto moved = incident.back();
+        incident[pos] = moved;
+        incident.pop_back();
+        auto& other = this->_edges[moved];
+        if (other.utx == vtx) {
+            other.pos_u = pos;
+        } else {
+            other.pos_v = pos;
+        }
+    }
+
+    std::vector<T> _gap;
+    std::vector<T> _weight;
+    std::vector<bool> _cover;
+    std::vector<std::vector<edge_id>> _incident;
+    std::vector<_Edge> _edges{};
+    std::vector<edge_id> _free{};
+    size_t _num_edges{0};
+    T _primal_cost{0};
+    T _dual_cost{0};
+};
@@ -0,0 +1,230 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @file edge_stream.hpp
+ * @brief Chunked edge-list readers for single-pass algorithms
+ *
+ * min_vertex_cover_pd_stream() looks at every edge once and keeps only
+ * per-vertex state. The readers below feed it from a file a chunk at a time,
+ * so the edge list is never held in memory as a whole:
+ *
+ * - BinaryEdgeReader: consecutive (u, v) pairs of native-endian uint32_t
+ * - TextEdgeReader: one "u v" per line, blank lines and lines starting with
+ *   '#' or '%' skipped, further tokens (weights, timestamps) ignored
+ *
+ * Both are input ranges of std::pair<uint32_t, uint32_t> that can be
+ * iterated once; begin() reads the first chunk. The ids come from outside,
+ * so each reader is given the number of nodes and throws on an id that is
+ * not smaller; min_vertex_cover_pd_stream() itself does not check.
+ *
+ *     auto edges = BinaryEdgeReader{"graph.bin", num_nodes};
+ *     auto cover = std::vector<bool>(num_nodes, false);
+ *     min_vertex_cover_pd_stream(edges, cover, weight);
+ */
+
+/** @brief (u, v) edge as produced by the edge readers */
+using StreamEdge = std::pair<uint32_t, uint32_t>;
+
+namespace {
+    /** @brief Throw unless both ends of edge are smaller than num_nodes */
+    inline auto _check_edge(const StreamEdge& edge, uint32_t num_nodes) -> void {
+        if (edge.first >= num_nodes || edge.second >= num_nodes) {
+            throw std::runtime_error("edge stream: vertex id out of range");
+        }
+    }
+}  // namespace
+
+/**
+ * @brief Input iterator over the chunks of an edge reader
+ *
+ * Walks the reader's current chunk and asks it for the next one at the end;
+ * compares equal to std::default_sentinel once the reader is exhausted.
+ *
+ * @tparam Reader edge reader with a `_fill() -> void` member refilling `_chunk`
+ */
+template <typename Reader> class EdgeStreamIterator {
+  public:
+    using value_type = StreamEdge;
+    using difference_type = std::ptrdiff_t;
+
+    EdgeStreamIterator() = default;
+    explicit EdgeStreamIterator(Reader& reader) : _reader{&reader} {}
+
+    auto operator*() const -> const StreamEdge& { return this->_reader->_chunk[this->_pos]; }
+
+    auto operator++() -> EdgeStreamIterator& {
+        if (++this->_pos == this->_reader->_chunk.size()) {
+            this->_reader->_fill();
+            this->_pos = 0;
+        }
+        return *this;
+    }
+    auto operator++(int) -> void { ++*this; }
+
+    auto operator==(std::default_sentinel_t /*end*/) const -> bool {
+        return this->_pos >= this->_reader->_chunk.size();
+    }
+
+  private:
+    Reader* _reader{nullptr};
+    size_t _pos{0};
+};
+
+/**
+ * @brief Edge list stored as raw native-endian uint32_t pairs
+ *
+ * The file is read in chunks of chunk_edges edges (8 bytes each) into one
+ * reused buffer.
+ */
+class BinaryEdgeReader {
+  public:
+    /**
+     * @param[in] path path of the binary edge file
+     * @param[in] num_nodes vertex ids must be smaller than this
+     * @param[in] chunk_edges number of edges read at a time
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit BinaryEdgeReader(const std::filesystem::path& path, uint32_t num_nodes,
+                              size_t chunk_edges = 1U << 20U)
+        : _input{path, std::ios::binary},
+          _num_nodes{num_nodes},
+          _chunk_edges{chunk_edges > 0 ? chunk_edges : 1} {
+        if (!this->_input) {
+            throw std::runtime_error("edge stream: cannot open " + path.string());
+        }
+    }
+
+    /** @throws std::runtime_error if the file size is not a multiple of 8 bytes,
+     *          or on a vertex id out of range */
+    auto begin() -> EdgeStreamIterator<BinaryEdgeReader> {
+        this->_fill();
+        return EdgeStreamIterator<BinaryEdgeReader>{*this};
+    }
+    auto end() const -> std::default_sentinel_t { return std::default_sentinel; }
+
+  private:
+    friend class EdgeStreamIterator<BinaryEdgeReader>;
+
+    auto _fill() -> void {
+        this->_chunk.resize(this->_chunk_edges);
+        this->_input.read(reinterpret_cast<char*>(this->_chunk.data()),
+                          static_cast<std::streamsize>(this->_chunk_edges * sizeof(StreamEdge)));
+        const auto bytes = static_cast<size_t>(this->_input.gcount());
+        if (bytes % sizeof(StreamEdge) != 0) {
+            throw std::runtime_error("edge stream: truncated binary edge file");
+        }
+        this->_chunk.resize(bytes / sizeof(StreamEdge));
+        for (const auto& edge : this->_chunk) {
+            _check_edge(edge, this->_num_nodes);
+        }
+    }
+
+    static_assert(sizeof(StreamEdge) == 2 * sizeof(uint32_t));
+
+    std::ifstream _input;
+    uint32_t _num_nodes;
+    size_t _chunk_edges;
+    std::vector<StreamEdge> _chunk{};
+};
+
+/**
+ * @brief Whitespace-separated text edge list, one edge per line
+ *
+ * Vertex ids are taken as they are (no 1-based shift). Up to chunk_edges
+ * lines are parsed at a time into one reused buffer.
+ */
+class TextEdgeReader {
+  public:
+    /**
+     * @param[in] input the edge list; must outlive the reader
+     * @param[in] num_nodes vertex ids must be smaller than this
+     * @param[in] chunk_edges number of edges parsed at a time
+     */
+    explicit TextEdgeReader(std::istream& input, uint32_t num_nodes,
+                            size_t chunk_edges = 1U << 16U)
+        : _input{&input}, _num_nodes{num_nodes}, _chunk_edges{chunk_edges > 0 ? chunk_edges : 1} {}
+
+    /**
+     * @param[in] path path of the text edge file
+     * @param[in] num_nodes vertex ids must be smaller than this
+     * @param[in] chunk_edges number of edges parsed at a time
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit TextEdgeReader(const std::filesystem::path& path, uint32_t num_nodes,
+                            size_t chunk_edges = 1U << 16U)
+        : _file{std::in_place, path},
+          _input{&*this->_file},
+          _num_nodes{num_nodes},
+          _chunk_edges{chunk_edges > 0 ? chunk_edges : 1} {
+        if (!*this->_file) {
+            throw std::runtime_error("edge stream: cannot open " + path.string());
+        }
+    }
+
+    TextEdgeReader(const TextEdgeReader&) = delete;
+    auto operator=(const TextEdgeReader&) -> TextEdgeReader& = delete;
+
+    /** @throws std::runtime_error on a line that does not start with two vertex ids,
+     *          or on a vertex id out of range */
+    auto begin() -> EdgeStreamIterator<TextEdgeReader> {
+        this->_fill();
+        return EdgeStreamIterator<TextEdgeReader>{*this};
+    }
+    auto end() const -> std::default_sentinel_t { return std::default_sentinel; }
+
+  private:
+    friend class EdgeStreamIterator<TextEdgeReader>;
+
+    /** @brief Parse the next vertex id of line at pos, advancing pos */
+    static auto _parse_id(std::string_view line, size_t& pos) -> uint32_t {
+        const auto first = line.find_first_not_of(" \t\r", pos);
+        const auto data = line.data();
+        const auto last = data + line.size();
+        auto value = uint32_t(0);
+        const auto [ptr, ec] = std::from_chars(
+            first == std::string_view::npos ? last : data + first, last, value);
+        if (ec != std::errc{} || (ptr != last && *ptr != ' ' && *ptr != '\t' && *ptr != '\r')) {
+            throw std::runtime_error("edge stream: bad edge line '" + std::string(line) + "'");
+        }
+        pos = static_cast<size_t>(ptr - data);
+        return value;
+    }
+
+    auto _fill() -> void {
+        this->_chunk.clear();
+        while (this->_chunk.size() != this->_chunk_edges
+               && std::getline(*this->_input, this->_line)) {
+            const auto first = this->_line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || this->_line[first] == '#'
+                || this->_line[first] == '%') {
+                continue;
+            }
+            auto pos = first;
+            const auto utx = _parse_id(this->_line, pos);
+            const auto vtx = _parse_id(this->_line, pos);
+            _check_edge(this->_chunk.emplace_back(utx, vtx), this->_num_nodes);
+        }
+    }
+
+    std::optional<std::ifstream> _file{};
+    std::istream* _input;
+    uint32_t _num_nodes;
+    size_t _chunk_edges;
+    std::string _line{};
+    std::vector<StreamEdge> _chunk{};
+};
@@ -0,0 +1,375 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+
+/**
+ * @file matrix_market.hpp
+ * @brief Build the optimal-scaling graph straight from a sparse matrix
+ *
+ * OptScalingOracle and optimal_scaling() take a graph whose edge (i, j)
+ * carries the pair (log|a_ij|, log|a_ji|). This module builds that graph as
+ * a CsrGraph from a list of (row, col, value) triplets -- any range, e.g. a
+ * std::span over a memory-mapped array -- or from a Matrix Market file,
+ * without per-node containers: the triplets are counting-sorted into the
+ * rows of a CSR matrix, each a_ij finds its partner a_ji by binary search
+ * in row j, and the graph's CSR arrays are filled directly from those rows.
+ *
+ * An entry without a partner (the sparsity pattern is not symmetric) still
+ * yields both of its constraints psi &le; a_ij + u_i - u_j &le; pi: edge
+ * (i, j) carries (log|a_ij|, -inf) and an extra edge (j, i) carries
+ * (+inf, log|a_ij|), so that min(pi - a_ji, a_ij - psi) keeps only the
+ * finite side.
+ */
+
+/** @brief One nonzero of a sparse matrix (0-based indices) */
+struct MatrixEntry {
+    uint32_t row;
+    uint32_t col;
+    double value;
+};
+
+namespace {
+    /** @brief What an off-diagonal entry a_ij also stands for at (j, i) */
+    enum class _Mirror {
+        None,        ///< nothing (general matrix)
+        Same,        ///< a_ji = a_ij (symmetric)
+        Negated,     ///< a_ji = -a_ij (skew-symmetric)
+        Conjugated,  ///< a_ji = conj(a_ij) (hermitian)
+    };
+
+    /**
+     * @brief Optimal-scaling graph from a two-pass source of nonzeros
+     *
+     * for_each_entry(fn) must call fn(row, col, value) for the same nonzeros
+     * each time it is called; it is called twice (count, then fill). The rows
+     * are held once as a CSR matrix of (col, a), merged into (col, log|a|);
+     * the graph's CSR arrays are then built directly and the rows are freed
+     * before the graph is assembled. The values are summed as Value (double
+     * or std::complex<double>), so the modulus is only taken of the sums.
+     */
+    template <typename Value, typename ForEach>
+    auto _scaling_graph(uint32_t num_nodes, _Mirror mirror, ForEach&& for_each_entry)
+        -> CsrGraph<std::pair<double, double>> {
+        using Entry = std::pair<uint32_t, Value>;  // (col, a), then (col, log|a|)
+        const auto symmetric = mirror != _Mirror::None;
+        const auto mirrored = [mirror](const Value& value) -> Value {
+            if (mirror == _Mirror::Negated) {
+                return -value;
+            }
+            if constexpr (!std::is_floating_point_v<Value>) {
+                if (mirror == _Mirror::Conjugated) {
+                    return std::conj(value);
+                }
+            }
+            return value;
+        };
+        const auto by_col = [](const Entry& lhs, const Entry& rhs) -> bool {
+            return lhs.first < rhs.first;
+        };
+
+        auto offsets = std::vector<size_t>(num_nodes + 1, 0);
+        for_each_entry([&](uint32_t row, uint32_t col, const Value& value) {
+            if (value != Value(0)) {
+                ++offsets[row + 1];
+                if (symmetric && row != col) {
+                    ++offsets[col + 1];
+                }
+            }
+        });
+        for (auto utx = 0U; utx != num_nodes; ++utx) {
+            offsets[utx + 1] += offsets[utx];
+        }
+        auto entries = std::vector<Entry>(offsets[num_nodes]);
+        auto fill = std::vector<size_t>(offsets.begin(), offsets.end() - 1);
+        for_each_entry([&](uint32_t row, uint32_t col, const Value& value) {
+            if (value != Value(0)) {
+                entries[fill[row]++] = {col, value};
+                if (symmetric && row != col) {
+                    entries[fill[col]++] = {row, mirrored(value)};
+                }
+            }
+        });
+        fill = {};
+
+        // sort every row, sum the duplicates of an entry and drop the sums that
+        // cancel out, compacting the rows in place; then take the logarithms
+        // (kept in the real part of a complex Value)
+        auto kept = size_t(0);
+        for (auto utx = 0U; utx != num_nodes; ++utx) {
+            const auto first = entries.begin() + static_cast<std::ptrdiff_t>(offsets[utx]);
+            const auto last = entries.begin() + static_cast<std::ptrdiff_t>(offsets[utx + 1]);
+            std::sort(first, last, by_col);
+            offsets[utx] = kept;
+            for (auto iter = first; iter != last;) {
+                auto sum = Entry{iter->first, Value(0)};
+                for (; iter != last && iter->first == sum.first; ++iter) {
+                    sum.second += iter->second;
+                }
+                if (sum.second != Value(0)) {
+                    entries[kept++] = {sum.first, Value(std::log(std::abs(sum.second)))};
+                }
+            }
+        }
+        offsets[num_nodes] = kept;
+        entries.resize(kept);
+
+        // a_ij is paired if a_ji is stored; otherwise it also yields the edge (j, i)
+        const auto inf = std::numeric_limits<double>::infinity();
+        auto partner = [&](uint32_t utx, uint32_t vtx) -> const Entry* {
+            const auto first = entries.begin() + offsets[vtx];
+            const auto last = entries.begin() + offsets[vtx + 1];
+            const auto iter = std::lower_bound(first, last, Entry{utx, Value(0)}, by_col);
+            return iter != last && iter->first == utx ? &*iter : nullptr;
+        };
+
+        auto graph_offsets = std::vector<uint32_t>(num_nodes + 1, 0U);
+        for (auto utx = 0U; utx != num_nodes; ++utx) {
+            for (auto pos = offsets[utx]; pos != offsets[utx + 1]; ++pos) {
+                const auto vtx = entries[pos].first;
+                ++graph_offsets[utx + 1];
+                if (partner(utx, vtx) == nullptr) {
+                    ++graph_offsets[vtx + 1];
+                }
+            }
+        }
+        for (auto utx = 0U; utx != num_nodes; ++utx) {
+            graph_offsets[utx + 1] += graph_offsets[utx];
+        }
+        auto targets = std::vector<uint32_t>(graph_offsets[num_nodes]);
+        auto payloads = std::vector<std::pair<double, double>>(targets.size());
+        auto slot = std::vector<uint32_t>(graph_offsets.begin(), graph_offsets.end() - 1);
+        for (auto utx = 0U; utx != num_nodes; ++utx) {
+            for (auto pos = offsets[utx]; pos != offsets[utx + 1]; ++pos) {
+                const auto vtx = entries[pos].first;
+                const auto aij = std::real(entries[pos].second);
+                const auto* const aji = partner(utx, vtx);
+                targets[slot[utx]] = vtx;
+                payloads[slot[utx]++] = {aij, aji != nullptr ? std::real(aji->second) : -inf};
+                if (aji == nullptr) {
+                    targets[slot[vtx]] = utx;
+                    payloads[slot[vtx]++] = {inf, aij};
+                }
+            }
+        }
+        slot = {};
+        entries = {};
+        offsets = {};
+        return {std::move(graph_offsets), std::move(targets), std::move(payloads)};
+    }
+}  // namespace
+
+/**
+ * @brief Build the optimal-scaling graph of a square sparse matrix
+ *
+ * The triplets are read twice (count, then fill) and never copied. Zero
+ * values are skipped; duplicates of an entry (i, j), including the mirror
+ * of (j, i) when symmetric, are summed, as in a COO to CSR conversion, and
+ * an entry whose values sum to zero is dropped.
+ *
+ * @tparam Triplets Range of MatrixEntry (or anything with row, col, value)
+ * @param[in] num_nodes order of the matrix (all indices must be smaller)
+ * @param[in] triplets the nonzeros
+ * @param[in] symmetric if true, every off-diagonal triplet also stands for
+ *            its mirror entry, as in a symmetric Matrix Market file
+ * @return CsrGraph<std::pair<double, double>> edge (i, j) carrying
+ *         (log|a_ij|, log|a_ji|)
+ */
+template <typename Triplets>
+auto scaling_graph(uint32_t num_nodes, const Triplets& triplets, bool symmetric = false)
+    -> CsrGraph<std::pair<double, double>> {
+    const auto mirror = symmetric ? _Mirror::Same : _Mirror::None;
+    return _scaling_graph<double>(num_nodes, mirror, [&](auto&& fn) {
+        for (const auto& elem : triplets) {
+            fn(elem.row, elem.col, static_cast<double>(elem.value));
+        }
+    });
+}
+
+namespace {
+    /** @brief Next whitespace-separated token of line, advancing pos */
+    inline auto _mm_token(std::string_view line, size_t& pos) -> std::string_view {
+        const auto first = line.find_first_not_of(" \t\r", pos);
+        if (first == std::string_view::npos) {
+            pos = line.size();
+            return {};
+        }
+        const auto last = std::min(line.find_first_of(" \t\r", first), line.size());
+        pos = last;
+        return line.substr(first, last - first);
+    }
+
+    template <typename T> auto _mm_parse(std::string_view token) -> T {
+        auto value = T{};
+        const auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+        if (ec != std::errc{} || ptr != token.data() + token.size()) {
+            throw std::runtime_error("matrix market: bad number '" + std::string(token) + "'");
+        }
+        return value;
+    }
+
+    /** @brief Next line that is neither a comment nor blank */
+    inline auto _mm_next_line(std::istream& input, std::string& line) -> bool {
+        while (std::getline(input, line)) {
+            if (line.find_first_not_of(" \t\r") != std::string::npos && line[0] != '%') {
+                return true;
+            }
+        }
+        return false;
+    }
+}  // namespace
+
+/**
+ * @brief Read a square Matrix Market coordinate file into the optimal-scaling graph
+ *
+ * Accepts the `real`, `integer`, `complex` (modulus taken) and `pattern`
+ * (every entry 1) fields with the `general`, `symmetric`, `skew-symmetric`
+ * (mirror -a_ij) and `hermitian` (mirror conj(a_ij)) symmetries. The
+ * entries are parsed twice, once to count the nonzeros of every row and
+ * once to fill them in, so only one CSR copy of the matrix is held while
+ * the graph is built; a stream that cannot seek back has its triplets
+ * buffered instead. Repeated entries are summed as in scaling_graph(),
+ * complex ones as complex numbers, before the modulus is taken.
+ *
+ * @param[in] input stream positioned at the `%%MatrixMarket` banner
+ * @return CsrGraph<std::pair<double, double>> edge (i, j) carrying
+ *         (log|a_ij|, log|a_ji|)
+ * @throws std::runtime_error if the file is malformed, not in coordinate
+ *         format or not square
+ */
+inline auto read_matrix_market(std::istream& input) -> CsrGraph<std::pair<double, double>> {
+    auto line = std::string{};
+    if (!std::getline(input, line) || !line.starts_with("%%MatrixMarket")) {
+        throw std::runtime_error("matrix market: missing banner");
+    }
+    std::transform(line.begin(), line.end(), line.begin(),
+                   [](unsigned char chr) { return static_cast<char>(std::tolower(chr)); });
+    auto pos = size_t(0);
+    _mm_token(line, pos);  // banner
+    const auto object = _mm_token(line, pos);
+    const auto format = _mm_token(line, pos);
+    const auto field = _mm_token(line, pos);
+    const auto symmetry = _mm_token(line, pos);
+    if (object != "matrix" || format != "coordinate") {
+        throw std::runtime_error("matrix market: only coordinate matrices are supported");
+    }
+    const auto pattern = field == "pattern";
+    const auto complex = field == "complex";
+    if (!pattern && !complex && field != "real" && field != "integer") {
+        throw std::runtime_error("matrix market: unknown field '" + std::string(field) + "'");
+    }
+    if (symmetry != "general" && symmetry != "symmetric" && symmetry != "skew-symmetric"
+        && symmetry != "hermitian") {
+        throw std::runtime_error("matrix market: unknown symmetry '" + std::string(symmetry)
+                                 + "'");
+    }
+
+    if (!_mm_next_line(input, line)) {
+        throw std::runtime_error("matrix market: missing size line");
+    }
+    pos = 0;
+    const auto num_rows = _mm_parse<uint32_t>(_mm_token(line, pos));
+    const auto num_cols = _mm_parse<uint32_t>(_mm_token(line, pos));
+    const auto num_entries = _mm_parse<size_t>(_mm_token(line, pos));
+    if (num_rows != num_cols) {
+        throw std::runtime_error("matrix market: optimal scaling needs a square matrix");
+    }
+
+    // the entries are parsed twice (count, then fill) instead of being buffered;
+    // a stream that cannot seek back falls back to buffering the triplets.
+    // Complex values stay complex until the duplicates have been summed.
+    const auto data_start = input.tellg();
+    const auto seekable = data_start != std::istream::pos_type(-1);
+    auto build = [&]<typename Value>() -> CsrGraph<std::pair<double, double>> {
+        auto mirror = _Mirror::None;
+        if (symmetry == "symmetric") {
+            mirror = _Mirror::Same;
+        } else if (symmetry == "skew-symmetric") {
+            mirror = _Mirror::Negated;
+        } else if (symmetry == "hermitian") {
+            mirror = _Mirror::Conjugated;
+        }
+        auto read_entries = [&](auto&& fn) {
+            if (seekable) {
+                input.clear();
+                input.seekg(data_start);
+            }
+            auto count = size_t(0);
+            while (count != num_entries && _mm_next_line(input, line)) {
+                pos = 0;
+                const auto row = _mm_parse<uint32_t>(_mm_token(line, pos));
+                const auto col = _mm_parse<uint32_t>(_mm_token(line, pos));
+                if (row == 0 || col == 0 || row > num_rows || col > num_cols) {
+                    throw std::runtime_error("matrix market: index out of range");
+                }
+                auto value = Value(1);
+                if (!pattern) {
+                    const auto real = _mm_parse<double>(_mm_token(line, pos));
+                    if constexpr (std::is_floating_point_v<Value>) {
+                        value = real;
+                    } else {
+                        value = Value(real, _mm_parse<double>(_mm_token(line, pos)));
+                    }
+                }
+                fn(row - 1, col - 1, value);
+                ++count;
+            }
+            if (count != num_entries) {
+                throw std::runtime_error("matrix market: fewer entries than announced");
+            }
+        };
+        if (!seekable) {
+            using Triplet = std::pair<std::pair<uint32_t, uint32_t>, Value>;
+            auto triplets = std::vector<Triplet>{};
+            triplets.reserve(num_entries);
+            read_entries([&](uint32_t row, uint32_t col, const Value& value) {
+                triplets.push_back({{row, col}, value});
+            });
+            return _scaling_graph<Value>(num_rows, mirror, [&](auto&& fn) {
+                for (const auto& [ends, value] : triplets) {
+                    fn(ends.first, ends.second, value);
+                }
+            });
+        }
+        return _scaling_graph<Value>(num_rows, mirror, read_entries);
+    };
+    if (complex) {
+        return build.template operator()<std::complex<double>>();
+    }
+    return build.template operator()<double>();
+}
+
+/**
+ * @brief Read a square Matrix Market coordinate file into the optimal-scaling graph
+ *
+ * @param[in] path path of the `.mtx` file
+ * @return CsrGraph<std::pair<double, double>> edge (i, j) carrying
+ *         (log|a_ij|, log|a_ji|)
+ * @throws std::runtime_error if the file cannot be opened or is malformed
+ */
+inline auto read_matrix_market(const std::filesystem::path& path)
+    -> CsrGraph<std::pair<double, double>> {
+    auto input = std::ifstream{path};
+    if (!input) {
+        throw std::runtime_error("matrix market: cannot open " + path.string());
+    }
+    return read_matrix_market(input);
+}
@@ -2,9 +2,14 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <py2cpp/py2cpp.hpp>
+#include <type_traits>
 
-#include "parametric.hpp"  // import max_parametric
+#include "csr_graph.hpp"           // import CsrGraph
+#include "parametric.hpp"          // import max_parametric
+#include "parametric_weights.hpp"  // import ParametricWeights
 
 /**
  * @file min_cycle_ratio.hpp
@@ -77,11 +82,13 @@
  * @param[in] get_time Function to extract time from edge data
  * @param[in,out] dist Distance mapping used in the algorithm
  * @param[in] max_iters Maximum number of iterations (default: 1000)
+ * @param[in,out] stats optional SolverStats to add counters and timings to
  * @return auto A cycle (vector of native edge data) with the minimum ratio
  */
-template <typename Graph, typename T, typename Fn1, typename Fn2, typename Mapping>
+template <typename Graph, typename T, typename Fn1, typename Fn2, typename Mapping,
+          typename Stats = NoStats>
 auto min_cycle_ratio(const Graph& gra, T& r0, Fn1&& get_cost, Fn2&& get_time, Mapping&& dist,
-                     size_t max_iters = 1000) {
+                     size_t max_iters = 1000, Stats&& stats = {}) {
     // ponytail: deduce Edge type using the same helpers as NegCycleFinder
     using Elem = decltype(*std::declval<const Graph&>().begin());
     using Nbrs = std::remove_cv_t<std::remove_reference_t<
@@ -106,6 +113,76 @@ auto min_cycle_ratio(const Graph& gra, T& r0, Fn1&& get_cost, Fn2&& get_time, Ma
     auto calc_weight
         = [&](const T& r, const edge_t& edge) -> T { return get_cost(edge) - r * T(get_time(edge)); };
 
-    return max_parametric(gra, r0, std::move(calc_weight), std::move(calc_ratio),
-                          std::forward<Mapping>(dist), max_iters);
+    // calc_ratio only iterates the cycle: edge-id views are fine on a CsrGraph
+    return max_parametric(gra, r0, std::move(calc_weight),
+                          edge_id_cycles(std::move(calc_ratio)), std::forward<Mapping>(dist),
+                          max_iters, std::forward<Stats>(stats));
+}
+
+/**
+ * @brief Solve the minimum cycle ratio problem with precomputed weights
+ *
+ * Same problem and result as min_cycle_ratio(), restricted to a CsrGraph.
+ * Cost and time are gathered once into arrays indexed by edge id
+ * (ParametricWeights); every time the ratio changes, the whole weight
+ * array is recomputed with one vectorized kernel, and Howard's inner loop
+ * only reads precomputed weights. Cycle ratios are computed from the
+ * gathered arrays as well, so get_cost and get_time are called exactly
+ * once per edge.
+ *
+ * @tparam Edge Type of the edge payload
+ * @tparam T Numeric type for ratio values (e.g., double, Fraction)
+ * @tparam Fn1 Type of cost function (edge_data -> cost)
+ * @tparam Fn2 Type of time function (edge_data -> time)
+ * @tparam Mapping Type of distance mapping (node id -> distance)
+ * @param[in] gra The input graph
+ * @param[in,out] r0 Initial ratio value, updated with optimal result
+ * @param[in] get_cost Function to extract cost from edge data
+ * @param[in] get_time Function to extract time from edge data
+ * @param[in,out] dist Distance mapping used in the algorithm
+ * @param[in] max_iters Maximum number of iterations (default: 1000)
+ * @return auto A cycle (vector of native edge data) with the minimum ratio
+ */
+template <typename Edge, typename T, typename Fn1, typename Fn2, typename Mapping>
+auto min_cycle_ratio_soa(const CsrGraph<Edge>& gra, T& r0, Fn1&& get_cost, Fn2&& get_time,
+                         Mapping&& dist, size_t max_iters = 1000) {
+    auto weights = ParametricWeights<T>(gra.edges(), get_cost, get_time);
+    auto get_weight = [&weights](uint32_t eid) -> const T& { return weights[eid]; };
+
+    auto ncf = NegCycleFinder<CsrGraph<Edge>>(gra);
+    ncf.warm_start(true);  // keep the policy across ratio updates
+    auto r_min = r0;
+    auto r_eval = r0;  // ratio the weights are evaluated at
+    auto c_min = std::vector<uint32_t>{};
+    auto c_opt = std::vector<uint32_t>{};
+
+    for (auto niter = 0U; niter != max_iters; ++niter) {
+        weights.update(r_eval);
+        for (const auto& ci : ncf.howard_ids(dist, get_weight)) {
+            auto ri = weights.ratio(ci);
+            if (r_min > ri) {
+                r_min = ri;
+                c_min.assign(ci.begin(), ci.end());
+            }
+        }
+        if (r_min >= r0) {
+            if constexpr (std::is_floating_point_v<T>) {
+                if (r_eval == r0 && !c_opt.empty()) {
+                    r_eval = _confirm_at(r0);  // one confirm run below r0
+                    continue;
+                }
+            }
+            break;
+        }
+        std::swap(c_opt, c_min);
+        r0 = r_min;
+        r_eval = r0;
+    }
+
+    auto cycle = std::vector<Edge>{};
+    cycle.reserve(c_opt.size());
+    for (const auto eid : c_opt) {
+        cycle.push_back(gra.edge(eid));
+    }
+    return cycle;
 }
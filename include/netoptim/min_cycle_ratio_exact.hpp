@@ -0,0 +1,130 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <cstdint>
+#include <py2cpp/fractions.hpp>  // import Fraction
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"  // import CsrGraph
+
+/**
+ * @file min_cycle_ratio_exact.hpp
+ * @brief Exact minimum cycle ratio in scaled integer arithmetic
+ *
+ * min_cycle_ratio() with fun::Fraction potentials gives exact answers, but
+ * every addition and comparison in Howard's relaxation normalizes a
+ * fraction with a gcd. When costs and times are integers, the current
+ * ratio r = p / q can be folded into the weights instead: the weight
+ * cost - r * time, scaled by q > 0, is the integer q * cost - p * time,
+ * and scaling by a positive factor does not change which cycles are
+ * negative. The relaxation then runs on plain integers, and a gcd is only
+ * taken when a better cycle produces a new ratio.
+ */
+
+namespace {
+    /** @brief gcd that also works for __int128 (std::gcd may not, outside gnu++ modes) */
+    template <typename Int> auto _exact_gcd(Int lhs, Int rhs) -> Int {
+        lhs = lhs < 0 ? -lhs : lhs;
+        rhs = rhs < 0 ? -rhs : rhs;
+        while (rhs != 0) {
+            lhs = std::exchange(rhs, lhs % rhs);
+        }
+        return lhs;
+    }
+}  // namespace
+
+/**
+ * @brief Solve the minimum cost-to-time cycle ratio problem exactly
+ *
+ * Same problem and result as min_cycle_ratio() with a fun::Fraction ratio:
+ * r0 is lowered to the minimum cycle ratio if some cycle beats it, and the
+ * critical cycle is returned (empty if no cycle beats r0).
+ *
+ * Costs and times must be integers, and every cycle must have a positive
+ * total time. The scaled weights and distances are computed in Int
+ * (int64_t by default); pass __int128 when q * cost, p * time or the path
+ * lengths may exceed 64 bits.
+ *
+ * @tparam Int Integer type of the scaled arithmetic
+ * @tparam Edge Type of the edge payload
+ * @tparam Z Integer type of the fraction
+ * @tparam Fn1 Type of cost function (edge_data -> integer cost)
+ * @tparam Fn2 Type of time function (edge_data -> integer time)
+ * @param[in] gra The input graph
+ * @param[in,out] r0 Initial ratio value, updated with optimal result
+ * @param[in] get_cost Function to extract cost from edge data
+ * @param[in] get_time Function to extract time from edge data
+ * @param[in] max_iters Maximum number of iterations (default: 1000)
+ * @return A cycle (vector of native edge data) with the minimum ratio
+ */
+template <typename Int = int64_t, typename Edge, typename Z, typename Fn1, typename Fn2>
+auto min_cycle_ratio_exact(const CsrGraph<Edge>& gra, fun::Fraction<Z>& r0, Fn1&& get_cost,
+                           Fn2&& get_time, size_t max_iters = 1000) -> std::vector<Edge> {
+    const auto num_edges = gra.num_edges();
+    auto costs = std::vector<Int>{};
+    auto times = std::vector<Int>{};
+    costs.reserve(num_edges);
+    times.reserve(num_edges);
+    for (const auto& edge : gra.edges()) {
+        costs.push_back(static_cast<Int>(get_cost(edge)));
+        times.push_back(static_cast<Int>(get_time(edge)));
+    }
+
+    auto num = static_cast<Int>(r0.num());
+    auto den = static_cast<Int>(r0.den());
+    auto weights = std::vector<Int>(num_edges);
+    auto dist = std::vector<Int>(gra.num_nodes(), Int(0));
+    auto ncf = NegCycleFinder<CsrGraph<Edge>>(gra);
+    ncf.warm_start(true);  // keep the policy across ratio updates
+    auto c_opt = std::vector<uint32_t>{};
+
+    for (auto niter = 0U; niter != max_iters; ++niter) {
+        for (auto eid = size_t(0); eid != num_edges; ++eid) {
+            weights[eid] = den * costs[eid] - num * times[eid];
+        }
+        auto best_cost = Int(0);
+        auto best_time = Int(0);
+        auto found = false;
+        for (const auto& ci : ncf.howard_ids(dist, [&weights](uint32_t eid) -> const Int& {
+                 return weights[eid];
+             })) {
+            auto total_cost = Int(0);
+            auto total_time = Int(0);
+            for (const auto eid : ci) {
+                total_cost += costs[eid];
+                total_time += times[eid];
+            }
+            // a negative cycle beats num / den; keep the smallest ratio
+            if (!found || total_cost * best_time < best_cost * total_time) {
+                best_cost = total_cost;
+                best_time = total_time;
+                c_opt.assign(ci.begin(), ci.end());
+                found = true;
+            }
+        }
+        if (!found) {
+            break;
+        }
+        const auto gcd = _exact_gcd(best_cost, best_time);
+        const auto new_den = best_time / gcd;
+        // rescale the potentials to the new denominator (warm start)
+        for (auto& val : dist) {
+            val = val / den * new_den + val % den * new_den / den;
+        }
+        num = best_cost / gcd;
+        den = new_den;
+    }
+
+    auto cycle = std::vector<Edge>{};
+    if (c_opt.empty()) {
+        return cycle;
+    }
+    r0 = fun::Fraction<Z>(static_cast<Z>(num), static_cast<Z>(den));
+    cycle.reserve(c_opt.size());
+    for (const auto eid : c_opt) {
+        cycle.push_back(gra.edge(eid));
+    }
+    return cycle;
+}
@@ -0,0 +1,92 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <ThreadPool.h>  // import ThreadPool
+
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "min_cycle_ratio.hpp"  // import min_cycle_ratio
+#include "scc.hpp"              // import nontrivial_sccs
+
+/**
+ * @file min_cycle_ratio_scc.hpp
+ * @brief Minimum cycle ratio solved per strongly connected component
+ *
+ * The minimum cycle ratio of a graph is the minimum over its strongly
+ * connected components (SCCs), and the acyclic part of a graph does not
+ * contribute at all. This front end splits the graph with Tarjan's
+ * algorithm, drops the trivial components and solves every remaining
+ * component independently with min_cycle_ratio(), in parallel on a
+ * ThreadPool. Components are scheduled largest first so that one giant
+ * component does not start last and leave the other workers idle.
+ */
+
+/**
+ * @brief Solve the minimum cost-to-time cycle ratio problem per SCC
+ *
+ * Same problem and result as min_cycle_ratio(): r0 is lowered to the
+ * minimum cycle ratio if some cycle beats it, and the critical cycle is
+ * returned (empty if no cycle beats r0). The distance potentials are
+ * internal, one vector per component.
+ *
+ * get_cost and get_time are called concurrently from the worker threads
+ * and must therefore be safe to call from several threads at once.
+ *
+ * @tparam Edge Type of the edge payload
+ * @tparam T Numeric type for ratio values (e.g., double, Fraction)
+ * @tparam Fn1 Type of cost function (edge_data -> cost)
+ * @tparam Fn2 Type of time function (edge_data -> time)
+ * @param[in] gra The input graph
+ * @param[in,out] r0 Initial ratio value, updated with optimal result
+ * @param[in] get_cost Function to extract cost from edge data
+ * @param[in] get_time Function to extract time from edge data
+ * @param[in] num_threads Number of worker threads (0 or 1: solve sequentially)
+ * @param[in] max_iters Maximum number of iterations per component (default: 1000)
+ * @return auto A cycle (vector of native edge data) with the minimum ratio
+ */
+template <typename Edge, typename T, typename Fn1, typename Fn2>
+auto min_cycle_ratio_scc(const CsrGraph<Edge>& gra, T& r0, Fn1&& get_cost, Fn2&& get_time,
+                         size_t num_threads = std::thread::hardware_concurrency(),
+                         size_t max_iters = 1000) -> std::vector<Edge> {
+    using Result = std::pair<T, std::vector<Edge>>;
+
+    const auto parts = nontrivial_sccs(gra);
+    const auto r_init = r0;
+    auto solve = [&](const SccSubgraph<Edge>& part) -> Result {
+        auto dist = std::vector<T>(part.graph.num_nodes(), T(0));
+        auto r = r_init;
+        auto cycle = min_cycle_ratio(part.graph, r, get_cost, get_time, dist, max_iters);
+        return {std::move(r), std::move(cycle)};
+    };
+
+    auto results = std::vector<Result>{};
+    results.reserve(parts.size());
+    if (num_threads <= 1 || parts.size() <= 1) {
+        for (const auto& part : parts) {
+            results.push_back(solve(part));
+        }
+    } else {
+        auto pool = ThreadPool(std::min(num_threads, parts.size()));
+        auto futures = std::vector<std::future<Result>>{};
+        futures.reserve(parts.size());
+        for (const auto& part : parts) {  // largest component first
+            futures.push_back(pool.enqueue(solve, std::cref(part)));
+        }
+        for (auto& fut : futures) {
+            results.push_back(fut.get());
+        }
+    }
+
+    auto c_opt = std::vector<Edge>{};
+    for (auto& [r, cycle] : results) {
+        if (!cycle.empty() && r0 > r) {
+            r0 = r;
+            c_opt = std::move(cycle);
+        }
+    }
+    return c_opt;
+}
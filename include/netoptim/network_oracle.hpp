@@ -1,9 +1,18 @@
 // -*- coding: utf-8 -*-
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <digraphx/neg_cycle.hpp>  // import NegCycleFinder
 #include <optional>
+#include <span>
+#include <tuple>
 #include <type_traits>
+#include <vector>
+
+#include "solver_stats.hpp"  // import SolverStats
 
 namespace {
     template <typename T>
@@ -30,8 +39,23 @@ namespace {
  * Edge weights are accessed via the actual edge data from the graph's
  * adjacency structure (the "get_weight" method), rather than synthesized
  * (u,v) node pairs. This matches the Python sibling implementation.
+ *
+ * On a graph with dense edge ids (CsrGraph), h(edge, x) is evaluated once
+ * per edge into an edge-indexed buffer. Howard's method and the cut both
+ * read that buffer, and reassess_feas() refreshes only the edges affected by
+ * a partial change of x. Before Howard's method runs, one sweep checks
+ * whether the potentials kept from the previous call still satisfy every
+ * edge; if they do, x is feasible and Howard's method is skipped.
+ * Optionally, the last few violated cycles are kept as edge-id lists and
+ * tried first (set_cycle_cache()).
  */
 
+/** @brief Which cut NetworkOracle::assess_feas() returns when infeasible */
+enum class CutMode {
+    First,    ///< the cut of the first negative cycle found (cheapest)
+    Deepest,  ///< the deepest cut (largest f / |g|) over all cycles of one Howard run
+};
+
 /**
  * @brief Oracle for Parametric Network Problems
  *
@@ -48,7 +72,15 @@ namespace {
  * @tparam Graph Type of the directed graph
  * @tparam Mapping Type of vertex potential mapping
  * @tparam Fn Type of the constraint function h, providing eval(edge, x) and
- *            grad(edge, x) methods operating on the graph's native edge data
+ *            grad(edge, x) methods operating on the graph's native edge data.
+ *            On a CsrGraph, h may also provide the batch method
+ *            eval_all(std::span<const Edge> edges, const Arr& x,
+ *            std::span<double> out), which writes h(edges[i], x) to out[i];
+ *            it is then used to evaluate all edges in a single call.
+ *            For a vector x, h may provide grad_sparse(edge, x) instead of
+ *            grad(edge, x), returning the nonzero entries of the gradient
+ *            as (index, value) pairs; the cut is then accumulated entry by
+ *            entry, in O(|C|) after a single zeroed gradient of size dim(x).
  */
 template <typename Graph, typename Mapping, typename Fn>
     requires HasKeyType<Graph>
@@ -56,10 +88,32 @@ class NetworkOracle {
     using node_t = typename Graph::key_type;
 
   private:
+    /** @brief True if edges have dense ids (CsrGraph): h(edge, x) is then buffered */
+    static constexpr auto dense_edges = requires(const Graph& gra) {
+        gra.num_edges();
+        gra.edge(uint32_t{0});
+    };
+
+    /** @brief True if Arr has a compile-time size, like std::array */
+    template <typename Arr>
+    static constexpr auto fixed_size = requires { std::tuple_size<Arr>::value; };
+
+    /** @brief True if h provides grad_sparse(edge, x) for a vector Arr */
+    template <typename Arr, typename Edge>
+    static constexpr auto sparse_grad = !std::is_arithmetic_v<Arr> && requires(
+        const Fn& h, const Edge& edge, const Arr& xval) { h.grad_sparse(edge, xval); };
+
     const Graph& _gra;
     Mapping& _u;  // vertex potentials
     NegCycleFinder<Graph> _S;
     Fn _h;
+    std::vector<double> _weights{};  // h(edge, x) by edge id (dense_edges only)
+    bool _weights_valid{false};      // _weights match the current h
+    CutMode _cut_mode{CutMode::First};
+    std::vector<std::vector<uint32_t>> _cycle_cache{};  // edge ids, most recently used first
+    size_t _cache_capacity{0};
+    size_t _cache_hits{0};
+    size_t _cache_misses{0};
 
   public:
     /** @brief Construct a new network oracle object
@@ -67,7 +121,11 @@ class NetworkOracle {
      * @param[in,out] utx vertex potential mapping (updated during operation)
      * @param[in] h function for constraint evaluation and gradient computation */
     NetworkOracle(const Graph& gra, Mapping& utx, Fn h)
-        : _gra{gra}, _u{utx}, _S(gra), _h{std::move(h)} {}
+        : _gra{gra}, _u{utx}, _S(gra), _h{std::move(h)} {
+        if constexpr (dense_edges) {
+            this->_weights.resize(gra.num_edges());
+        }
+    }
 
     /** @brief Copy constructor */
     explicit NetworkOracle(const NetworkOracle&) = default;
@@ -77,7 +135,10 @@ class NetworkOracle {
      * parameter value, typically used in parametric optimization where
      * the constraints depend on a parameter that changes during the algorithm.
      * @param[in] gamma the new parameter value (best-so-far optimal value) */
-    template <typename Num> auto update(const Num& gamma) -> void { this->_h.update(gamma); }
+    template <typename Num> auto update(const Num& gamma) -> void {
+        this->_h.update(gamma);
+        this->_weights_valid = false;
+    }
 
     /** @brief Assess feasibility and generate cutting plane if needed
      * @details This is the main oracle method that checks if the current point
@@ -114,10 +175,171 @@ class NetworkOracle {
  *
      * @tparam Arr Type of the input array/vector
      * @param[in] xval input values to be assessed for feasibility
+     * @param[in,out] stats optional SolverStats to add counters and timings to
+     * @return Empty if feasible, otherwise a pair containing gradient and
+     *         function value */
+    template <typename Arr, typename Stats = NoStats>
+    auto assess_feas(const Arr& xval, Stats&& stats = {})
+        -> std::optional<std::pair<Arr, double>> {
+        return this->_select_cut(xval, stats, [this, &xval, &stats] {
+            this->_refresh_all(xval, stats);
+        });
+    }
+
+    /** @brief Assess feasibility after a partial change of x
+     * @details Same as assess_feas(), but the edge values buffered by the
+     * previous call are reused: only the edges in changed_edges (those whose
+     * h(edge, x) depends on the part of x that changed) are evaluated again.
+     * If nothing is buffered yet, or update() was called since, all edges
+     * are evaluated. Only available for graphs with dense edge ids
+     * (CsrGraph).
+     * @tparam Arr Type of the input array/vector
+     * @param[in] xval input values to be assessed for feasibility
+     * @param[in] changed_edges ids of the edges to evaluate again
+     * @param[in,out] stats optional SolverStats to add counters and timings to
      * @return Empty if feasible, otherwise a pair containing gradient and
      *         function value */
-    template <typename Arr> auto assess_feas(const Arr& xval)
+    template <typename Arr, typename Stats = NoStats>
+        requires dense_edges
+    auto reassess_feas(const Arr& xval, std::span<const uint32_t> changed_edges,
+                       Stats&& stats = {}) -> std::optional<std::pair<Arr, double>> {
+        if (!this->_weights_valid) {
+            return this->assess_feas(xval, stats);
+        }
+        return this->_select_cut(xval, stats, [this, &xval, &stats, changed_edges] {
+            for (const auto eid : changed_edges) {
+                this->_evaluate(eid, xval, stats);
+            }
+        });
+    }
+
+    /** @brief Assess feasibility and return a cut for every violated cycle
+     * @details Runs Howard's method once, like assess_feas(), but builds a
+     * cut from each negative cycle it reports instead of the first one only:
+     * a bundle for parallel-cut updates. The cycles of one run are
+     * node-disjoint.
+     * @tparam Arr Type of the input array/vector
+     * @param[in] xval input values to be assessed for feasibility
+     * @param[in,out] stats optional SolverStats to add counters and timings to
+     * @return the cuts (gradient, function value); empty if feasible */
+    template <typename Arr, typename Stats = NoStats>
+    auto assess_feas_bundle(const Arr& xval, Stats&& stats = {})
+        -> std::vector<std::pair<Arr, double>> {
+        auto cuts = std::vector<std::pair<Arr, double>>{};
+        this->_assess(
+            xval, stats, [this, &xval, &stats] { this->_refresh_all(xval, stats); },
+            [&cuts](std::pair<Arr, double>&& cut) -> bool {
+                cuts.push_back(std::move(cut));
+                return false;
+            });
+        return cuts;
+    }
+
+    /** @brief Choose which cut assess_feas() returns
+     * @param[in] mode CutMode::First (default) or CutMode::Deepest */
+    auto set_cut_mode(CutMode mode) -> void { this->_cut_mode = mode; }
+
+    /** @brief Keep the capacity most recently violated cycles (CsrGraph only)
+     * @details Before the feasibility check, the cached cycles are evaluated
+     * at the new x; if one of them is still negative, its cut is returned
+     * without running Howard's method. 0 (the default) disables the cache.
+     * @param[in] capacity maximum number of cached cycles */
+    auto set_cycle_cache(size_t capacity) -> void {
+        this->_cache_capacity = capacity;
+        if (this->_cycle_cache.size() > capacity) {
+            this->_cycle_cache.resize(capacity);
+        }
+    }
+
+    /** @brief Calls answered by a cached cycle */
+    auto cycle_cache_hits() const -> size_t { return this->_cache_hits; }
+
+    /** @brief Calls with an enabled cache that had to go on to the full check */
+    auto cycle_cache_misses() const -> size_t { return this->_cache_misses; }
+
+    /** @brief Function call operator for cutting plane methods
+     * @details Makes the oracle callable for use with cutting plane algorithms.
+     * Forwards to the assess_feas method.
+     * @tparam Arr Type of the input array/vector
+     * @param[in] xvar input variables to be assessed
+     * @return Same as assess_feas */
+    template <typename Arr> auto operator()(const Arr& xvar)
         -> std::optional<std::pair<Arr, double>> {
+        return this->assess_feas(xvar);
+    }
+
+  private:
+    /** @brief Buffer h(edge, x) of edge eid */
+    template <typename Arr, typename Stats>
+    auto _evaluate(uint32_t eid, const Arr& xval, Stats& stats) -> void {
+        if constexpr (_collects_stats<Stats>) {
+            ++stats.edge_evaluations;
+        }
+        this->_weights[eid] = this->_h.eval(this->_gra.edge(eid), xval);
+    }
+
+    /** @brief Buffer h(edge, x) of all edges (no-op without dense edge ids) */
+    template <typename Arr, typename Stats>
+    auto _refresh_all(const Arr& xval, Stats& stats) -> void {
+        if constexpr (dense_edges) {
+            const auto edges = this->_gra.edges();
+            if constexpr (requires { this->_h.eval_all(edges, xval, std::span<double>{}); }) {
+                // batch protocol: one call for all edges
+                if constexpr (_collects_stats<Stats>) {
+                    stats.edge_evaluations += edges.size();
+                }
+                this->_h.eval_all(edges, xval, std::span<double>{this->_weights});
+            } else {
+                for (auto eid = 0U; eid != this->_gra.num_edges(); ++eid) {
+                    this->_evaluate(eid, xval, stats);
+                }
+            }
+            this->_weights_valid = true;
+        }
+    }
+
+    /** @brief Depth of a cut: its function value over the norm of its gradient */
+    template <typename Arr> static auto _depth(const std::pair<Arr, double>& cut) -> double {
+        const auto& [grad, fval] = cut;
+        auto norm2 = 0.0;
+        if constexpr (std::is_arithmetic_v<Arr>) {
+            norm2 = double(grad) * double(grad);
+        } else {
+            for (const auto& val : grad) {
+                norm2 += double(val) * double(val);
+            }
+        }
+        return norm2 > 0.0 ? fval / std::sqrt(norm2) : fval;
+    }
+
+    /** @brief Run _assess() and keep the cut selected by the cut mode */
+    template <typename Arr, typename Stats, typename Refresh>
+    auto _select_cut(const Arr& xval, Stats& stats, Refresh&& refresh)
+        -> std::optional<std::pair<Arr, double>> {
+        auto best = std::optional<std::pair<Arr, double>>{};
+        auto best_depth = 0.0;
+        this->_assess(xval, stats, refresh, [&](std::pair<Arr, double>&& cut) -> bool {
+            if (this->_cut_mode == CutMode::First) {
+                best = std::move(cut);
+                return true;  // stop at the first cycle
+            }
+            const auto depth = _depth(cut);
+            if (!best || depth > best_depth) {
+                best = std::move(cut);
+                best_depth = depth;
+            }
+            return false;
+        });
+        return best;
+    }
+
+    /** @brief Run Howard's method and hand the cut of each negative cycle to on_cut
+     * @details With dense edge ids, refresh() fills the edge value buffer
+     * and Howard reads it by edge id, so the cut reuses the buffered values
+     * instead of evaluating the cycle edges again. Otherwise h is evaluated
+     * on the fly. The cycles are visited until on_cut returns true. */
+    template <typename Arr, typename Stats, typename Refresh, typename OnCut>
+    auto _assess(const Arr& xval, Stats& stats, Refresh&& refresh, OnCut&& on_cut) -> void {
         // ponytail: deduce Edge type using NegCycleFinder helpers
         using Elem = decltype(*std::declval<const Graph&>().begin());
         using Nbrs = std::remove_cv_t<std::remove_reference_t<
@@ -126,36 +348,171 @@ class NetworkOracle {
         using Edge = std::remove_cv_t<std::remove_reference_t<
             decltype(_get_val(std::declval<NbrElem>(), std::declval<const Nbrs&>()))>>;
 
-        auto get_weight = [this, &xval](const Edge& edge) -> double {
-            return this->_h.eval(edge, xval);
-        };
-
-        for (auto&& C : this->_S.howard(this->_u, get_weight)) {
+        constexpr auto collect = _collects_stats<Stats>;
+        [[maybe_unused]] const auto t_start = _stats_now<Stats>();
+        [[maybe_unused]] const auto passes_before = [this] {
+            if constexpr (collect && requires { this->_S.relax_passes(); }) {
+                return this->_S.relax_passes();
+            } else {
+                return NoStats{};
+            }
+        }();
+        [[maybe_unused]] auto t_first = _stats_now<Stats>();  // first cycle reported
+        auto num_cuts = size_t(0);
+        auto make_cut = [&](const auto& cycle, auto&& weight_of, auto&& edge_of) {
+            if constexpr (collect) {
+                if (num_cuts == 0) {
+                    t_first = std::chrono::steady_clock::now();
+                }
+                ++stats.cycles;
+                ++stats.improving_cycles;
+            }
+            ++num_cuts;
             auto grad = [&]() -> Arr {
-                if constexpr (std::is_arithmetic_v<Arr>) {
-                    return Arr{};
+                if constexpr (std::is_arithmetic_v<Arr> || fixed_size<Arr>) {
+                    return Arr{};  // zero-initialized
                 } else {
                     return Arr(xval.size());
                 }
             }();
             auto fval = 0.0;
-            for (auto&& edge : C) {
-                fval -= this->_h.eval(edge, xval);
-                grad -= this->_h.grad(edge, xval);
+            for (auto&& item : cycle) {
+                const auto& edge = edge_of(item);
+                fval -= weight_of(item);
+                if constexpr (sparse_grad<Arr, Edge>) {
+                    for (const auto& [idx, val] : this->_h.grad_sparse(edge, xval)) {
+                        grad[idx] -= val;
+                    }
+                } else {
+                    grad -= this->_h.grad(edge, xval);
+                }
             }
             return std::pair{std::move(grad), fval};
+        };
+
+        [[maybe_unused]] const auto t_howard = _stats_now<Stats>();
+        refresh();
+        if constexpr (dense_edges) {
+            // recently violated cycles first, then the kept potentials, then Howard
+            if (!this->_cached_cuts(on_cut, make_cut)) {
+                if (!this->_certificate_holds()) {
+                    this->_howard_cuts(on_cut, make_cut);
+                } else if constexpr (collect) {
+                    ++stats.certificate_hits;
+                }
+            }
+        } else {
+            auto get_weight = [&](const Edge& edge) -> double {
+                if constexpr (collect) {
+                    ++stats.edge_evaluations;
+                }
+                return this->_h.eval(edge, xval);
+            };
+            auto eval = [this, &xval](const Edge& edge) { return this->_h.eval(edge, xval); };
+            auto edge_of = [](const Edge& edge) -> const Edge& { return edge; };
+            for (auto&& C : this->_S.howard(this->_u, get_weight)) {
+                if (on_cut(make_cut(C, eval, edge_of))) {
+                    break;
+                }
+            }
+        }
+        if constexpr (collect) {
+            const auto t_end = std::chrono::steady_clock::now();
+            ++stats.iterations;
+            if constexpr (requires { this->_S.relax_passes(); }) {
+                stats.howard_passes += this->_S.relax_passes() - passes_before;
+            }
+            if (num_cuts == 0) {
+                stats.howard_time += t_end - t_howard;
+            } else {
+                stats.howard_time += t_first - t_howard;
+                stats.cycle_time += t_end - t_first;
+            }
+            stats.total_time += t_end - t_start;
         }
-        return {};
     }
 
-    /** @brief Function call operator for cutting plane methods
-     * @details Makes the oracle callable for use with cutting plane algorithms.
-     * Forwards to the assess_feas method.
-     * @tparam Arr Type of the input array/vector
-     * @param[in] xvar input variables to be assessed
-     * @return Same as assess_feas */
-    template <typename Arr> auto operator()(const Arr& xvar)
-        -> std::optional<std::pair<Arr, double>> {
-        return this->assess_feas(xvar);
+    /** @brief Check whether the potentials still certify feasibility
+     * @details The kept potentials u certify that there is no negative
+     * cycle if u[v] <= u[u] + w(u, v) for every edge. The check is one
+     * branch-free sweep that only reads the buffered edge values; it
+     * replaces Howard's method whenever x moved little enough for the old
+     * potentials to stay valid. */
+    auto _certificate_holds() const -> bool {
+        const auto offsets = this->_gra.offsets();
+        const auto targets = this->_gra.targets();
+        const auto edge_ids = this->_gra.edge_ids();
+        auto violated = 0U;
+        for (auto utx = 0U; utx != this->_gra.num_nodes(); ++utx) {
+            const auto du = this->_u[utx];
+            for (auto slot = offsets[utx]; slot != offsets[utx + 1]; ++slot) {
+                violated += static_cast<unsigned>(this->_u[targets[slot]]
+                                                  > du + this->_weights[edge_ids[slot]]);
+            }
+        }
+        return violated == 0;
+    }
+
+    /** @brief Howard's method on the buffered edge values (dense edge ids) */
+    template <typename OnCut, typename MakeCut>
+    auto _howard_cuts(OnCut& on_cut, MakeCut& make_cut) -> void {
+        using Edge = std::remove_cvref_t<decltype(this->_gra.edge(0))>;
+        auto weight_of = [this](uint32_t eid) -> double { return this->_weights[eid]; };
+        auto edge_of = [this](uint32_t eid) -> const Edge& { return this->_gra.edge(eid); };
+        for (const auto& ids : this->_S.howard_ids(this->_u, weight_of)) {
+            this->_remember(ids);
+            if (on_cut(make_cut(ids, weight_of, edge_of))) {
+                break;
+            }
+        }
+    }
+
+    /** @brief Hand the cut of every cached cycle that is still negative to on_cut
+     * @details Cached cycles are re-evaluated on the buffered edge values,
+     * in O(|C|) each, most recently used first. A negative one is moved to
+     * the front.
+     * @return true if a cached cycle was negative (a cache hit) */
+    template <typename OnCut, typename MakeCut>
+    auto _cached_cuts(OnCut& on_cut, MakeCut& make_cut) -> bool {
+        if (this->_cache_capacity == 0) {
+            return false;
+        }
+        using Edge = std::remove_cvref_t<decltype(this->_gra.edge(0))>;
+        auto weight_of = [this](uint32_t eid) -> double { return this->_weights[eid]; };
+        auto edge_of = [this](uint32_t eid) -> const Edge& { return this->_gra.edge(eid); };
+        auto hit = false;
+        for (auto idx = size_t(0); idx != this->_cycle_cache.size(); ++idx) {
+            auto total = 0.0;
+            for (const auto eid : this->_cycle_cache[idx]) {
+                total += this->_weights[eid];
+            }
+            if (!(total < 0.0)) {
+                continue;
+            }
+            hit = true;
+            auto first = this->_cycle_cache.begin();
+            std::rotate(first, first + static_cast<std::ptrdiff_t>(idx),
+                        first + static_cast<std::ptrdiff_t>(idx) + 1);
+            if (on_cut(make_cut(this->_cycle_cache.front(), weight_of, edge_of))) {
+                break;
+            }
+        }
+        ++(hit ? this->_cache_hits : this->_cache_misses);
+        return hit;
+    }
+
+    /** @brief Put a cycle found by Howard's method at the front of the cache */
+    auto _remember(std::span<const uint32_t> ids) -> void {
+        if (this->_cache_capacity == 0) {
+            return;
+        }
+        if (this->_cycle_cache.size() < this->_cache_capacity) {
+            this->_cycle_cache.emplace_back();
+        }
+        // reuse the storage of the least recently used entry
+        auto& slot = this->_cycle_cache.back();
+        slot.assign(ids.begin(), ids.end());
+        std::rotate(this->_cycle_cache.begin(), this->_cycle_cache.end() - 1,
+                    this->_cycle_cache.end());
     }
 };
@@ -0,0 +1,234 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+#include "min_cycle_ratio.hpp"    // import min_cycle_ratio
+#include "parametric.hpp"         // import max_parametric
+#include "parametric_solver.hpp"  // import ParametricSolver
+
+/**
+ * @file optimal_scaling.hpp
+ * @brief Optimal matrix scaling solved directly with parametric shortest paths
+ *
+ * OptScalingOracle states optimal diagonal scaling as a two-variable problem
+ * in x = (pi, psi) for an external ellipsoid method:
+ *
+ *     min     pi - psi
+ *     s.t.    u[j] - u[i] &le; min(pi - a_ji, a_ij - psi)
+ *             &forall; edge(i, j) carrying (a_ij, a_ji)
+ *
+ * (all quantities in log scale). For a fixed psi, the smallest feasible pi
+ * is a maximum parametric problem in r = -pi: the edge weights
+ * min(-r - a_ji, a_ij - psi) decrease in r, so max_parametric() solves it
+ * exactly, one Howard run per improving cycle. The smallest feasible pi is
+ * a convex function of psi (the lower boundary of the feasible region of
+ * a linear program), hence so is the objective pi(psi) - psi, and a
+ * golden-section search over psi finds its minimum.
+ *
+ * psi is bounded above by the minimum cycle mean of a_ij (beyond it no pi
+ * is feasible), and below by min(a) - (max(a) - min(a)), since the unscaled
+ * matrix already achieves a gap of max(a) - min(a).
+ */
+
+namespace {
+    /**
+     * @brief Smallest pi at which a cycle is not negative any more
+     *
+     * The cycle weight F(pi) = sum min(pi - a_ji, a_ij - psi) is increasing,
+     * concave and piecewise linear, so Newton steps started left of the
+     * root (where the cycle is negative) stay left of it and reach it after
+     * at most one step per edge.
+     *
+     * @return the root, or +inf if the cycle is negative for every pi
+     */
+    template <typename Cycle, typename Fn>
+    auto _scaling_root(const Cycle& cycle, Fn& get_cost, double psi, double pi) -> double {
+        for (auto step = size_t(0); step <= std::size(cycle); ++step) {
+            auto total = 0.0;
+            auto slope = 0.0;
+            for (const auto& edge : cycle) {
+                const auto [aij, aji] = get_cost(edge);
+                if (pi - aji < aij - psi) {
+                    total += pi - aji;
+                    slope += 1.0;
+                } else {
+                    total += aij - psi;
+                }
+            }
+            if (total >= 0.0) {
+                break;
+            }
+            if (slope == 0.0) {
+                return std::numeric_limits<double>::infinity();
+            }
+            pi -= total / slope;
+        }
+        return pi;
+    }
+
+    /**
+     * @brief Smallest feasible pi for a fixed psi
+     *
+     * solve(r_opt, distance, zero_cancel) runs one maximum parametric solve,
+     * warm-started from the current potentials; zero_cancel takes the cycle
+     * as a range of edge payloads. Every cycle root is raised by slack: a
+     * cycle that is negative only by rounding would otherwise yield no
+     * progress, and the solve would stop before the rest of the graph is
+     * relaxed.
+     */
+    template <typename Solve, typename Fn>
+    auto _scaling_min_pi(Solve& solve, Fn& get_cost, double psi, double slack) -> double {
+        // pi >= max(b) >= min(b) >= psi, so r = -psi is not below the optimum
+        auto r_opt = -psi;
+        auto distance = [&get_cost, psi](const double& r, const auto& edge) -> double {
+            const auto [aij, aji] = get_cost(edge);
+            return std::min(-r - aji, aij - psi);
+        };
+        auto zero_cancel = [&get_cost, &r_opt, psi, slack](const auto& cycle) -> double {
+            return -_scaling_root(cycle, get_cost, psi, -r_opt) - slack;
+        };
+        solve(r_opt, distance, zero_cancel);
+        return -r_opt;
+    }
+
+    /**
+     * @brief Golden-section search of optimal_scaling()
+     *
+     * min_mean(psi_hi) lowers psi_hi to (at least close to) the minimum cycle
+     * mean of a_ij; stopping above it only widens the bracket, as no pi is
+     * feasible there. solve is as in _scaling_min_pi(); the potentials of
+     * its last call are those of the optimum.
+     */
+    template <typename Graph, typename Fn, typename MinMean, typename Solve>
+    auto _optimal_scaling(const Graph& gra, Fn& get_cost, double tol, MinMean&& min_mean,
+                          Solve&& solve) -> std::pair<double, double> {
+        auto a_min = std::numeric_limits<double>::infinity();
+        auto a_max = -std::numeric_limits<double>::infinity();
+        for (auto&& [utx, nbrs] : gra) {
+            for (auto&& [vtx, edge] : nbrs) {
+                const auto [aij, aji] = get_cost(edge);
+                for (const auto aval : {aij, aji}) {
+                    if (std::isfinite(aval)) {  // +-inf: no partner entry (see matrix_market.hpp)
+                        a_min = std::min(a_min, aval);
+                        a_max = std::max(a_max, aval);
+                    }
+                }
+            }
+        }
+        if (a_min > a_max) {
+            return {0.0, 0.0};  // no entries
+        }
+
+        // upper bound of psi: the minimum cycle mean of a_ij
+        auto psi_hi = a_max;
+        min_mean(psi_hi);
+        auto psi_lo = a_min - (a_max - a_min);
+
+        const auto eps = tol * std::max(1.0, a_max - a_min);
+        auto gap = [&](double psi) -> double {
+            return _scaling_min_pi(solve, get_cost, psi, eps) - psi;
+        };
+
+        // golden-section search for the minimum of the convex gap(psi)
+        const auto inv_phi = (std::sqrt(5.0) - 1.0) / 2.0;
+        auto psi_1 = psi_hi - inv_phi * (psi_hi - psi_lo);
+        auto psi_2 = psi_lo + inv_phi * (psi_hi - psi_lo);
+        auto gap_1 = gap(psi_1);
+        auto gap_2 = gap(psi_2);
+        while (psi_hi - psi_lo > eps) {
+            if (gap_1 <= gap_2) {
+                psi_hi = psi_2;
+                psi_2 = psi_1;
+                gap_2 = gap_1;
+                psi_1 = psi_hi - inv_phi * (psi_hi - psi_lo);
+                gap_1 = gap(psi_1);
+            } else {
+                psi_lo = psi_1;
+                psi_1 = psi_2;
+                gap_1 = gap_2;
+                psi_2 = psi_lo + inv_phi * (psi_hi - psi_lo);
+                gap_2 = gap(psi_2);
+            }
+        }
+
+        // final solve at the best psi leaves its potentials behind
+        const auto psi = gap_1 <= gap_2 ? psi_1 : psi_2;
+        const auto pi = _scaling_min_pi(solve, get_cost, psi, eps);
+        return {pi, psi};
+    }
+}  // namespace
+
+/**
+ * @brief Solve the optimal matrix scaling problem without the ellipsoid method
+ *
+ * Same problem as OptScalingOracle with cutting_plane_optim(), solved by a
+ * golden-section search over psi with an exact parametric solve for pi at
+ * every step.
+ *
+ * @tparam Graph Type of the directed graph representing matrix sparsity
+ * @tparam Fn Type of the cost function (edge -> pair (a_ij, a_ji) in log scale)
+ * @tparam Mapping Type of vertex potential mapping
+ * @param[in] gra The graph representing matrix sparsity
+ * @param[in] get_cost Function to extract matrix entry pairs from edge data
+ * @param[out] dist The scaling potentials u (log scale) of the optimal solution
+ * @param[in] tol Tolerance of psi and pi, relative to max(a) - min(a)
+ * @param[in] max_iters Maximum number of iterations of each parametric solve
+ * @return std::pair<double, double> The optimal (pi, psi)
+ */
+template <typename Graph, typename Fn, typename Mapping>
+auto optimal_scaling(const Graph& gra, Fn&& get_cost, Mapping&& dist, double tol = 1e-9,
+                     size_t max_iters = 1000) -> std::pair<double, double> {
+    auto min_mean = [&](double& psi_hi) -> void {
+        min_cycle_ratio(
+            gra, psi_hi, [&get_cost](const auto& edge) -> double { return get_cost(edge).first; },
+            [](const auto& /*edge*/) -> double { return 1.0; }, dist, max_iters);
+    };
+    auto solve = [&](double& r_opt, auto& distance, auto& zero_cancel) -> void {
+        max_parametric(gra, r_opt, distance, edge_id_cycles(zero_cancel), dist, max_iters);
+    };
+    return _optimal_scaling(gra, get_cost, tol, min_mean, solve);
+}
+
+/**
+ * @brief Solve the optimal matrix scaling problem of solver.graph() in place
+ *
+ * Same as optimal_scaling() above, except that every parametric solve runs
+ * on the buffers of solver: no finder, policy or cycle vector is built per
+ * solve. The potentials are reset first and the optimal ones are left in
+ * solver.dist(). Rebind the solver to reuse it for the next graph.
+ *
+ * @tparam Edge Type of the edge payload
+ * @tparam Fn Type of the cost function (edge -> pair (a_ij, a_ji) in log scale)
+ * @param[in,out] solver solver bound to the graph representing matrix sparsity
+ * @param[in] get_cost Function to extract matrix entry pairs from edge data
+ * @param[in] tol Tolerance of psi and pi, relative to max(a) - min(a)
+ * @param[in] max_iters Maximum number of iterations of each parametric solve
+ * @return std::pair<double, double> The optimal (pi, psi)
+ */
+template <typename Edge, typename Fn>
+auto optimal_scaling(ParametricSolver<CsrGraph<Edge>, double>& solver, Fn&& get_cost,
+                     double tol = 1e-9, size_t max_iters = 1000) -> std::pair<double, double> {
+    solver.reset();
+    auto min_mean = [&](double& psi_hi) -> void {
+        auto distance = [&get_cost](const double& r, const Edge& edge) -> double {
+            return get_cost(edge).first - r;
+        };
+        auto cycle_mean = [&get_cost](const auto& cycle) -> double {
+            auto total = 0.0;
+            for (const auto& edge : cycle) {
+                total += get_cost(edge).first;
+            }
+            return total / static_cast<double>(std::size(cycle));
+        };
+        solver.solve(psi_hi, distance, cycle_mean, max_iters);
+    };
+    auto solve = [&](double& r_opt, auto& distance, auto& zero_cancel) -> void {
+        solver.solve(r_opt, distance, zero_cancel, max_iters);
+    };
+    return _optimal_scaling(solver.graph(), get_cost, tol, min_mean, solve);
+}
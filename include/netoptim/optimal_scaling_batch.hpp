@@ -0,0 +1,108 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <ThreadPool.h>  // import ThreadPool
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "optimal_scaling.hpp"    // import optimal_scaling
+#include "parametric_solver.hpp"  // import ParametricSolver
+
+/**
+ * @file optimal_scaling_batch.hpp
+ * @brief Optimal scaling of many independent sparse blocks on a ThreadPool
+ *
+ * A preconditioner scales many independent blocks per step. This front end
+ * solves every block with optimal_scaling() in parallel and returns the
+ * results in input order. Blocks are handed out largest first (by number of
+ * edges) from a shared counter, so a worker that finishes early takes the
+ * next block instead of waiting on a fixed partition, and one huge block
+ * starts at once rather than last.
+ */
+
+/** @brief Optimal scaling of one block */
+struct ScalingResult {
+    double pi{0.0};              ///< largest scaled entry (log scale)
+    double psi{0.0};             ///< smallest scaled entry (log scale)
+    std::vector<double> dist{};  ///< scaling potentials u, one per row (log scale)
+};
+
+/**
+ * @brief Solve optimal_scaling() for every block of a batch
+ *
+ * Each worker owns one ParametricSolver and rebinds it to every block it
+ * takes, so the finder, policy, potentials and cycle buffers are allocated
+ * once per worker and reused by every parametric solve of every block;
+ * a block allocates only its own output. get_cost is called concurrently from the worker threads and must
+ * therefore be safe to call from several threads at once.
+ *
+ * @tparam Problems Random-access range of CsrGraph blocks
+ * @tparam Fn Type of the cost function (edge -> pair (a_ij, a_ji) in log scale)
+ * @param[in] problems the blocks, e.g. a std::vector<CsrGraph<Edge>>
+ * @param[in] get_cost Function to extract matrix entry pairs from edge data
+ * @param[in] num_threads Number of worker threads (0 or 1: solve sequentially)
+ * @param[in] tol Tolerance of the search over psi (see optimal_scaling())
+ * @param[in] max_iters Maximum number of iterations of each parametric solve
+ * @return std::vector<ScalingResult> one result per block, in input order
+ */
+template <typename Problems, typename Fn>
+auto optimal_scaling_batch(const Problems& problems, Fn&& get_cost,
+                           size_t num_threads = std::thread::hardware_concurrency(),
+                           double tol = 1e-9, size_t max_iters = 1000)
+    -> std::vector<ScalingResult> {
+    const auto num_problems = static_cast<size_t>(std::size(problems));
+    auto results = std::vector<ScalingResult>(num_problems);
+
+    // largest block first
+    auto order = std::vector<size_t>(num_problems);
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&problems](size_t lhs, size_t rhs) {
+        return problems[lhs].num_edges() > problems[rhs].num_edges();
+    });
+
+    // one solver per worker, rebound to each block it takes: its buffers are
+    // sized by the worker's first (largest) block and reused from then on
+    using Solver = ParametricSolver<std::remove_cvref_t<decltype(problems[0])>, double>;
+    auto next = std::atomic<size_t>{0};
+    auto work = [&]() -> void {
+        auto solver = std::optional<Solver>{};
+        for (auto pos = next++; pos < num_problems; pos = next++) {
+            const auto idx = order[pos];
+            if (solver) {
+                solver->rebind(problems[idx]);
+            } else {
+                solver.emplace(problems[idx]);
+            }
+            auto& result = results[idx];
+            const auto [pi, psi] = optimal_scaling(*solver, get_cost, tol, max_iters);
+            const auto dist = solver->dist();
+            result.dist.assign(dist.begin(), dist.end());
+            result.pi = pi;
+            result.psi = psi;
+        }
+    };
+
+    if (num_threads <= 1 || num_problems <= 1) {
+        work();
+    } else {
+        const auto num_workers = std::min(num_threads, num_problems);
+        auto pool = ThreadPool(num_workers);
+        auto futures = std::vector<std::future<void>>{};
+        futures.reserve(num_workers);
+        for (auto idx = size_t(0); idx != num_workers; ++idx) {
+            futures.push_back(pool.enqueue(work));
+        }
+        for (auto& fut : futures) {
+            fut.get();
+        }
+    }
+    return results;
+}
@@ -1,7 +1,13 @@
 // -*- coding: utf-8 -*-
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <utility>
 #include <valarray>
 
 #include "network_oracle.hpp"
@@ -41,11 +47,13 @@
  * @tparam Graph Type of the directed graph representing matrix sparsity
  * @tparam Mapping Type of vertex potential mapping (scaling factors)
  * @tparam Fn Type of the cost function (edge -> matrix entry pair)
+ * @tparam Vec Type of x = (pi, psi) and of the cut gradients: std::valarray<double>
+ *             (default) or a fixed-size std::array<double, 2>, with which
+ *             neither the cuts nor their construction touch the heap
  */
-template <typename Graph, typename Mapping, typename Fn>  //
+template <typename Graph, typename Mapping, typename Fn, typename Vec = std::valarray<double>>  //
     requires HasKeyType<Graph>
 class OptScalingOracle {
-    using Vec = std::valarray<double>;
     using node_t = typename Graph::key_type;
     using Cut = std::pair<Vec, double>;
 
@@ -99,6 +107,24 @@ class OptScalingOracle {
             return std::min(x[0] - aji, aij - x[1]);
         }
 
+        /** @brief Evaluate the constraint function for all edges at once
+         * @details Batch form of eval() used by NetworkOracle on a CsrGraph:
+         * out[i] = eval(edges[i], x). x is read once, and the loop body has
+         * no branch, so the compiler can vectorize it.
+         * @param[in] edges the matrix entries (edges) to evaluate
+         * @param[in] x vector containing (pi, psi) in log scale
+         * @param[out] out constraint values, one per edge */
+        template <typename Edge>
+        auto eval_all(std::span<const Edge> edges, const Vec& x, std::span<double> out) const
+            -> void {
+            const auto pi = x[0];
+            const auto psi = x[1];
+            for (auto idx = size_t(0); idx != edges.size(); ++idx) {
+                const auto [aij, aji] = this->_get_cost(edges[idx]);
+                out[idx] = std::min(pi - aji, aij - psi);
+            }
+        }
+
         /** @brief Compute the gradient of the constraint function
          * @details Returns a subgradient vector indicating which bound is
  * active: [1.0, 0.0] if the upper bound (pi) is active, or
@@ -134,6 +160,21 @@ class OptScalingOracle {
             const auto [aij, aji] = this->_get_cost(edge);
             return (x[0] - aji < aij - x[1]) ? Vec{1., 0.} : Vec{0., -1.};
         }
+
+        /** @brief Sparse form of grad(): its single nonzero entry
+         * @details Used by NetworkOracle to accumulate a cut in place, so no
+         * gradient vector is created per cycle edge.
+         * @param[in] edge the matrix entry (edge) for gradient computation
+         * @param[in] x vector containing (pi, psi) in log scale
+         * @return (0, 1.0) if the pi bound is active, (1, -1.0) otherwise */
+        auto grad_sparse(const auto& edge, const Vec& x) const
+            -> std::array<std::pair<size_t, double>, 1> {
+            const auto [aij, aji] = this->_get_cost(edge);
+            if (x[0] - aji < aij - x[1]) {
+                return {{{0, 1.0}}};
+            }
+            return {{{1, -1.0}}};
+        }
     };
 
     NetworkOracle<Graph, Mapping, Ratio> _network;
@@ -188,17 +229,19 @@ class OptScalingOracle {
      * @return tuple of (cut, whether gamma was updated)
      * @see cutting_plane_optim */
     auto assess_optim(const Vec& x, double& t) -> std::tuple<Cut, bool> {
-        const auto cut = this->_network.assess_feas(x);
+        auto cut = this->_network.assess_feas(x);
         if (cut) {
-            return {*cut, false};
+            return {std::move(*cut), false};
         }
         auto s = x[0] - x[1];
         auto fj = s - t;
-        if (fj < 0) {
+        const auto improved = fj < 0;
+        if (improved) {
             t = s;
-            return {{Vec{1., -1.}, 0.}, true};
+            fj = 0.;
         }
-        return {{Vec{1., -1.}, fj}, false};
+        // the gradient is built in place in the result and moved, never copied
+        return {Cut{Vec{1., -1.}, fj}, improved};
     }
 
     /** @brief Function call operator for cutting_plane_optim()
@@ -1,10 +1,20 @@
 // -*- coding: utf-8 -*-
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
 #include <digraphx/neg_cycle.hpp>  // import NegCycleFinder
+#include <limits>
+#include <span>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "solve_control.hpp"  // import SolveControl
+#include "solver_stats.hpp"   // import SolverStats
+
 /**
  * @file parametric.hpp
  * @brief Maximum parametric problem solver for network optimization
@@ -28,8 +38,222 @@
  * method), rather than synthesized (u,v) node pairs. This eliminates the
  * duplication present in the previous node-pair-based approach and
  * matches the Python sibling implementation.
+ *
+ * For large graphs, convert the input once with `to_csr` (csr_graph.hpp);
+ * Howard's method then sweeps contiguous offset/target/edge-id arrays, and
+ * the policy found in one iteration is reused as the starting policy of the
+ * next one (warm start) instead of being rebuilt from scratch.
+ *
+ * On a CsrGraph, wrapping zero_cancel in edge_id_cycles() enumerates the
+ * cycles as spans of edge ids into the finder's arena, and zero_cancel reads
+ * the payloads through a `CsrGraph::EdgeIdView`. No payload is copied in the
+ * loop; only the returned critical cycle is materialized.
  */
 
+/** @brief zero_cancel that asked for edge-id cycles (see edge_id_cycles()) */
+template <typename Fn> struct EdgeIdCycles {
+    Fn zero_cancel;
+};
+
+/**
+ * @brief Let max_parametric() hand the cycles to zero_cancel as edge-id views
+ *
+ * On a CsrGraph, `max_parametric(gra, r, distance, edge_id_cycles(fn), dist)`
+ * calls fn with a `CsrGraph::EdgeIdView`: a forward range of `const Edge&`
+ * with size() and empty(), but without operator[], front() or back(). On
+ * other graphs fn receives the usual vector of payloads, so it must accept
+ * both; a generic lambda that only iterates the cycle does. Without the
+ * wrapper, zero_cancel always receives a vector of payloads.
+ *
+ * @param[in] zero_cancel function to compute new parameter from cycle
+ * @return EdgeIdCycles holding zero_cancel
+ */
+template <typename Fn> auto edge_id_cycles(Fn&& zero_cancel) -> EdgeIdCycles<std::decay_t<Fn>> {
+    return {std::forward<Fn>(zero_cancel)};
+}
+
+namespace {
+    template <typename Fn> constexpr auto _is_edge_id_cycles = false;
+    template <typename Fn> constexpr auto _is_edge_id_cycles<EdgeIdCycles<Fn>> = true;
+
+    /**
+     * @brief Parameter at which a floating-point optimum is confirmed
+     *
+     * At r_opt the critical cycle weighs zero up to rounding (of the weights
+     * and of the distances, which grow large over the iterations), so Howard
+     * -- warm-started or not -- may close it again before any better cycle,
+     * and the search would stop early. One more run at r_opt lowered by a
+     * relative sqrt(eps) makes that cycle positive, so that only a better
+     * cycle can be reported.
+     */
+    template <typename T> auto _confirm_at(const T& r_opt) -> T {
+        const auto margin = std::sqrt(std::numeric_limits<T>::epsilon());
+        return r_opt - margin * std::max(T(1), std::abs(r_opt));
+    }
+
+    /** @brief max_parametric() with optional statistics and stop conditions */
+    template <typename Graph, typename T, typename Fn1, typename Fn2, typename Mapping,
+              typename Stats, typename Control>
+    auto _max_parametric(const Graph& gra, T& r_opt, Fn1& distrance, Fn2& zero_cancel,
+                         Mapping& dist, size_t max_iters, Stats& stats, const Control& control) {
+        // ponytail: deduce Edge type using the same helpers as NegCycleFinder
+        using Elem = decltype(*std::declval<const Graph&>().begin());
+        using Nbrs = std::remove_cv_t<std::remove_reference_t<
+            decltype(_get_val(std::declval<Elem>(), std::declval<const Graph&>()))>>;
+        using NbrElem = decltype(*std::declval<const Nbrs&>().begin());
+        using Edge = std::remove_cv_t<std::remove_reference_t<
+            decltype(_get_val(std::declval<NbrElem>(), std::declval<const Nbrs&>()))>>;
+        using Cycle = std::vector<Edge>;
+        using CycleIds = std::vector<uint32_t>;
+        constexpr auto collect = _collects_stats<Stats>;
+        constexpr auto controlled = _has_control<Control>;
+        [[maybe_unused]] const auto t_start = _stats_now<Stats>();
+
+        auto r_eval = r_opt;  // parameter the weights are evaluated at
+        auto get_weight = [&](const Edge& edge) -> T {
+            if constexpr (collect) {
+                ++stats.edge_evaluations;
+            }
+            return static_cast<T>(distrance(r_eval, edge));
+        };
+
+        auto ncf = NegCycleFinder<Graph>(gra);
+        if constexpr (requires { ncf.warm_start(true); }) {
+            ncf.warm_start(true);  // keep the policy across ratio updates
+        }
+        // edge ids only when asked for with edge_id_cycles() (and on a CsrGraph)
+        constexpr auto wrapped = _is_edge_id_cycles<std::remove_cvref_t<Fn2>>;
+        auto& cancel = [&zero_cancel]() -> auto& {
+            if constexpr (wrapped) {
+                return zero_cancel.zero_cancel;
+            } else {
+                return zero_cancel;
+            }
+        }();
+        constexpr auto by_id = wrapped && requires(std::span<const uint32_t> ids) {
+            gra.edge(uint32_t{0});
+            gra.edges_of(ids);
+        };
+        if constexpr (by_id) {
+            static_assert(requires(std::span<const uint32_t> ids) {
+                { cancel(gra.edges_of(ids)) } -> std::convertible_to<T>;
+            }, "edge_id_cycles(): zero_cancel must accept a CsrGraph::EdgeIdView");
+        }
+        // polled inside the relaxation sweeps of finders that support it
+        auto stop = [&control]() -> bool {
+            if constexpr (controlled) {
+                return control.check().has_value();
+            } else {
+                return false;
+            }
+        };
+        // by_id: edge ids into the finder's arena; otherwise copied payloads
+        auto find_cycles = [&]() -> decltype(auto) {
+            if constexpr (by_id) {
+                return ncf.howard_ids(
+                    dist, [&](uint32_t eid) -> T { return get_weight(gra.edge(eid)); }, stop);
+            } else if constexpr (controlled && requires { ncf.howard(dist, get_weight, stop); }) {
+                return ncf.howard(dist, get_weight, stop);
+            } else {
+                return ncf.howard(dist, get_weight);
+            }
+        };
+        auto r_min = r_opt;
+        auto c_min = std::conditional_t<by_id, CycleIds, Cycle>{};
+        auto c_opt = decltype(c_min){};
+        auto status = SolveStatus::MaxIters;
+        auto niter = size_t(0);
+        if constexpr (by_id) {
+            c_min.reserve(gra.num_nodes());
+            c_opt.reserve(gra.num_nodes());
+        }
+
+        for (; niter != max_iters; ++niter) {
+            if constexpr (controlled) {
+                if (const auto reason = control.check()) {
+                    status = *reason;
+                    break;
+                }
+            }
+            [[maybe_unused]] const auto t_howard = _stats_now<Stats>();
+            [[maybe_unused]] auto cycle_time = SolverStats::duration{};
+            auto found = false;  // the run ended on cycles, not on a feasible fixpoint
+            for (auto&& ci : find_cycles()) {
+                found = true;
+                [[maybe_unused]] const auto t_cycle = _stats_now<Stats>();
+                auto ri = [&]() -> T {
+                    if constexpr (by_id) {
+                        return static_cast<T>(cancel(gra.edges_of(ci)));
+                    } else {
+                        return static_cast<T>(cancel(ci));
+                    }
+                }();
+                if constexpr (collect) {
+                    ++stats.cycles;
+                    cycle_time += std::chrono::steady_clock::now() - t_cycle;
+                }
+                if (r_min > ri) {
+                    if constexpr (collect) {
+                        ++stats.improving_cycles;
+                    }
+                    r_min = ri;
+                    if constexpr (by_id) {
+                        c_min.assign(ci.begin(), ci.end());
+                    } else {
+                        c_min = std::move(ci);
+                    }
+                }
+            }
+            if constexpr (collect) {
+                ++stats.iterations;
+                stats.howard_time += std::chrono::steady_clock::now() - t_howard - cycle_time;
+                stats.cycle_time += cycle_time;
+            }
+            if constexpr (controlled) {
+                // a stopped run is incomplete: keep the result of the last full one
+                if (const auto reason = control.check()) {
+                    status = *reason;
+                    break;
+                }
+            }
+            if (r_min >= r_opt) {
+                if constexpr (std::is_floating_point_v<T>) {
+                    if (found && r_eval == r_opt) {
+                        r_eval = _confirm_at(r_opt);  // one confirm run below r_opt
+                        continue;
+                    }
+                }
+                status = SolveStatus::Converged;
+                break;
+            }
+            std::swap(c_opt, c_min);
+            r_opt = r_min;
+            r_eval = r_opt;
+            if constexpr (controlled) {
+                if (control.progress) {
+                    control.progress(niter + 1, r_opt);
+                }
+            }
+        }
+        if constexpr (collect) {
+            if constexpr (requires { ncf.relax_passes(); }) {
+                stats.howard_passes += ncf.relax_passes();
+            }
+            stats.total_time += std::chrono::steady_clock::now() - t_start;
+        }
+        auto result = AnytimeResult<Cycle>{{}, status, niter};
+        if constexpr (by_id) {
+            result.cycle.reserve(c_opt.size());
+            for (const auto& edge : gra.edges_of(c_opt)) {
+                result.cycle.push_back(edge);
+            }
+        } else {
+            result.cycle = std::move(c_opt);
+        }
+        return result;
+    }
+}  // namespace
+
 /**
  * @brief Solve the maximum parametric problem
  *
@@ -47,6 +271,11 @@
  *    using the zero_cancel callable
  * 5. Repeat until convergence or max_iters reached
  *
+ * For a floating-point r, a run that finds cycles but none below r_opt is
+ * repeated once with the weights evaluated slightly below r_opt before
+ * convergence is declared: rounding can make the critical cycle look
+ * negative again and hide a better one.
+ *
  * The parametric problem is defined as:
  * @f[
  *     \max \; r \quad \text{s.t.} \quad d_v - d_u \ge w(u, v, r) \; \forall (u, v) \in E
@@ -57,7 +286,8 @@
  * @tparam Graph Type of the directed graph
  * @tparam T Numeric type for the parameter r
  * @tparam Fn1 Type of the distance function (parameter, edge) -> weight
- * @tparam Fn2 Type of the zero-canceling function (cycle) -> parameter
+ * @tparam Fn2 Type of the zero-canceling function (cycle) -> parameter, or
+ *             EdgeIdCycles (see edge_id_cycles())
  * @tparam Mapping Type of distance mapping (vertex -> distance)
  * @param[in] gra directed graph containing the network structure
  * @param[in,out] r_opt parameter to be maximized, updated with optimal value
@@ -65,40 +295,50 @@
  * @param[in] zero_cancel function to compute new parameter from cycle
  * @param[in,out] dist distance mapping used in the algorithm
  * @param[in] max_iters maximum number of iterations (default: 1000)
+ * @param[in,out] stats optional SolverStats to add counters and timings to
  * @return auto the critical cycle that determines the optimal parameter
  */
-template <typename Graph, typename T, typename Fn1, typename Fn2, typename Mapping>
+template <typename Graph, typename T, typename Fn1, typename Fn2, typename Mapping,
+          typename Stats = NoStats>
 auto max_parametric(const Graph& gra, T& r_opt, Fn1&& distrance, Fn2&& zero_cancel, Mapping&& dist,
-                    size_t max_iters = 1000) {
-    // ponytail: deduce Edge type using the same helpers as NegCycleFinder
-    using Elem = decltype(*std::declval<const Graph&>().begin());
-    using Nbrs = std::remove_cv_t<std::remove_reference_t<
-        decltype(_get_val(std::declval<Elem>(), std::declval<const Graph&>()))>>;
-    using NbrElem = decltype(*std::declval<const Nbrs&>().begin());
-    using Edge = std::remove_cv_t<std::remove_reference_t<
-        decltype(_get_val(std::declval<NbrElem>(), std::declval<const Nbrs&>()))>>;
-    using Cycle = std::vector<Edge>;
-
-    auto get_weight = [&distrance, &r_opt](const Edge& edge) -> T {
-        return static_cast<T>(distrance(r_opt, edge));
-    };
-
-    auto ncf = NegCycleFinder<Graph>(gra);
-    auto r_min = r_opt;
-    auto c_min = Cycle{};
-    auto c_opt = Cycle{};
+                    size_t max_iters = 1000, Stats&& stats = {}) {
+    return _max_parametric(gra, r_opt, distrance, zero_cancel, dist, max_iters, stats, NoControl{})
+        .cycle;
+}
 
-    for (auto niter = 0U; niter != max_iters; ++niter) {
-        for (auto&& ci : ncf.howard(dist, get_weight)) {
-            auto ri = static_cast<T>(zero_cancel(ci));
-            if (r_min > ri) {
-                r_min = ri;
-                c_min = std::move(ci);
-            }
-        }
-        if (r_min >= r_opt) break;
-        c_opt = std::move(c_min);
-        r_opt = r_min;
-    }
-    return c_opt;
+/**
+ * @brief Solve the maximum parametric problem under a deadline or cancellation
+ *
+ * Same algorithm as max_parametric(), but the solve also ends when
+ * control.stop_token is stopped or control.deadline passes, and
+ * control.progress (if set) is called after every iteration that lowered
+ * r_opt. An iteration interrupted by a stop is discarded, so r_opt and the
+ * returned cycle are always those of the last completed iteration: the best
+ * ratio found so far, optimal only if the result is converged().
+ *
+ * The stop conditions are checked between Howard runs; on a CsrGraph they
+ * are also polled inside the relaxation sweeps.
+ *
+ * @tparam Graph Type of the directed graph
+ * @tparam T Numeric type for the parameter r
+ * @tparam Fn1 Type of the distance function (parameter, edge) -> weight
+ * @tparam Fn2 Type of the zero-canceling function (cycle) -> parameter, or
+ *             EdgeIdCycles (see edge_id_cycles())
+ * @tparam Mapping Type of distance mapping (vertex -> distance)
+ * @param[in] gra directed graph containing the network structure
+ * @param[in,out] r_opt parameter to be maximized, updated with the best value found
+ * @param[in] distrance monotone decreasing function of parameter r
+ * @param[in] zero_cancel function to compute new parameter from cycle
+ * @param[in,out] dist distance mapping used in the algorithm
+ * @param[in] control stop token, deadline and progress callback
+ * @param[in] max_iters maximum number of iterations (default: 1000)
+ * @param[in,out] stats optional SolverStats to add counters and timings to
+ * @return AnytimeResult with the best cycle so far and the reason the solve ended
+ */
+template <typename Graph, typename T, typename Fn1, typename Fn2, typename Mapping,
+          typename Stats = NoStats>
+auto max_parametric_until(const Graph& gra, T& r_opt, Fn1&& distrance, Fn2&& zero_cancel,
+                          Mapping&& dist, const SolveControl<std::type_identity_t<T>>& control,
+                          size_t max_iters = 1000, Stats&& stats = {}) {
+    return _max_parametric(gra, r_opt, distrance, zero_cancel, dist, max_iters, stats, control);
 }
@@ -0,0 +1,157 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"   // import CsrGraph, NegCycleFinder
+#include "parametric.hpp"  // import _confirm_at
+
+/**
+ * @file parametric_solver.hpp
+ * @brief Reusable maximum parametric solver with preallocated buffers
+ *
+ * max_parametric() builds a negative cycle finder, its policy and the cycle
+ * vectors from scratch on every call. Callers that solve the same graph
+ * over and over (e.g. an incremental sizing loop) pay for those
+ * allocations every time. ParametricSolver is constructed once per graph
+ * and owns all scratch state: potentials, edge weights, the Howard policy
+ * and the cycle storage. After construction, solve() does not touch the
+ * heap. Potentials and policy carry over from one solve() to the next as a
+ * warm start.
+ */
+
+/**
+ * @brief Stateful solver for the maximum parametric problem
+ *
+ * Only the CsrGraph specialization is provided: dense node and edge ids are
+ * what makes fixed-size buffers possible.
+ *
+ * @tparam Graph Type of the directed graph
+ * @tparam T Numeric type for the parameter r
+ */
+template <typename Graph, typename T> class ParametricSolver;
+
+/**
+ * @brief Stateful solver for the maximum parametric problem on a CsrGraph
+ *
+ * @tparam Edge Type of the edge payload
+ * @tparam T Numeric type for the parameter r
+ */
+template <typename Edge, typename T> class ParametricSolver<CsrGraph<Edge>, T> {
+    using Graph = CsrGraph<Edge>;
+
+    const Graph* _gra;
+    NegCycleFinder<Graph> _ncf;
+    std::vector<T> _dist;
+    std::vector<T> _weights;        // edge weights for the current r
+    std::vector<uint32_t> _c_min{};  // best cycle of the current iteration
+    std::vector<uint32_t> _c_opt{};  // critical cycle
+
+  public:
+    using CycleView = typename Graph::EdgeIdView;
+
+    /** @brief Construct a solver for gra
+     * @param[in] gra the graph (must outlive the solver) */
+    explicit ParametricSolver(const Graph& gra)
+        : _gra{&gra},
+          _ncf(gra),
+          _dist(gra.num_nodes(), T(0)),
+          _weights(gra.num_edges(), T(0)) {
+        this->_ncf.warm_start(true);  // keep the policy across ratio updates
+        this->_c_min.reserve(gra.num_nodes());
+        this->_c_opt.reserve(gra.num_nodes());
+    }
+
+    /**
+     * @brief Solve the maximum parametric problem
+     *
+     * Same algorithm and result as max_parametric(), except that the
+     * critical cycle is reported as edge ids and zero_cancel receives a
+     * CycleView (a range of `const Edge&`) instead of a vector of payloads.
+     * Like max_parametric(), a run that only re-finds the critical cycle at
+     * r_opt is repeated once just below r_opt before it counts as optimal.
+     *
+     * @tparam Fn1 Type of the distance function (parameter, edge) -> weight
+     * @tparam Fn2 Type of the zero-canceling function (CycleView) -> parameter
+     * @param[in,out] r_opt parameter to be maximized, updated with optimal value
+     * @param[in] distance monotone decreasing function of parameter r
+     * @param[in] zero_cancel function to compute new parameter from cycle
+     * @param[in] max_iters maximum number of iterations (default: 1000)
+     * @return the edge ids of the critical cycle (empty if r_opt was not
+     *         lowered); valid until the next call
+     */
+    template <typename Fn1, typename Fn2>
+    auto solve(T& r_opt, Fn1&& distance, Fn2&& zero_cancel, size_t max_iters = 1000)
+        -> std::span<const uint32_t> {
+        const auto& gra = *this->_gra;
+        auto get_weight = [this](uint32_t eid) -> const T& { return this->_weights[eid]; };
+        auto r_min = r_opt;
+        auto r_eval = r_opt;  // parameter the weights are evaluated at
+        this->_c_min.clear();
+        this->_c_opt.clear();
+
+        for (auto niter = 0U; niter != max_iters; ++niter) {
+            for (auto eid = 0U; eid != gra.num_edges(); ++eid) {
+                this->_weights[eid] = static_cast<T>(distance(r_eval, gra.edge(eid)));
+            }
+            auto found = false;  // the run ended on cycles, not on a feasible fixpoint
+            for (const auto& ci : this->_ncf.howard_ids(this->_dist, get_weight)) {
+                found = true;
+                auto ri = static_cast<T>(zero_cancel(gra.edges_of(ci)));
+                if (r_min > ri) {
+                    r_min = std::move(ri);
+                    this->_c_min.assign(ci.begin(), ci.end());
+                }
+            }
+            if (r_min >= r_opt) {
+                if constexpr (std::is_floating_point_v<T>) {
+                    if (found && r_eval == r_opt) {
+                        r_eval = _confirm_at(r_opt);  // one confirm run below r_opt
+                        continue;
+                    }
+                }
+                break;
+            }
+            std::swap(this->_c_opt, this->_c_min);
+            r_opt = r_min;
+            r_eval = r_opt;
+        }
+        return this->_c_opt;
+    }
+
+    /** @brief Switch to another graph, keeping the buffers
+     * @details Potentials and policy start from scratch. The buffers only
+     * reallocate if gra is larger than any graph seen before, so one solver
+     * can serve a sequence of graphs (largest first: no allocation at all).
+     * @param[in] gra the graph (must outlive the solver) */
+    auto rebind(const Graph& gra) -> void {
+        this->_gra = &gra;
+        this->_ncf.rebind(gra);
+        this->_dist.assign(gra.num_nodes(), T(0));
+        this->_weights.assign(gra.num_edges(), T(0));
+        this->_c_min.clear();
+        this->_c_opt.clear();
+        this->_c_min.reserve(gra.num_nodes());
+        this->_c_opt.reserve(gra.num_nodes());
+    }
+
+    /** @brief The graph being solved */
+    auto graph() const -> const Graph& { return *this->_gra; }
+
+    /** @brief Payloads of the critical cycle of the last solve() */
+    auto cycle() const -> CycleView { return this->_gra->edges_of(this->_c_opt); }
+
+    /** @brief Potentials (indexed by node id), kept across calls */
+    auto dist() -> std::span<T> { return this->_dist; }
+
+    /** @brief Forget the warm start: zero potentials and an empty policy */
+    auto reset() -> void {
+        std::fill(this->_dist.begin(), this->_dist.end(), T(0));
+        this->_ncf.reset_policy();
+    }
+};
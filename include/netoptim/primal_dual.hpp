@@ -19,6 +19,73 @@
  * approximation ratios for the independent set problem.
  */
 
+namespace {
+    /** @brief True if edge (utx, vtx) is covered; one word-level test on a DenseBitset */
+    template <typename C1, typename Node>
+    auto _pd_covered(C1& cover, const Node& utx, const Node& vtx) -> bool {
+        if constexpr (requires { cover.test_any(utx, vtx); }) {
+            return cover.test_any(utx, vtx);
+        } else {
+            return cover[utx] || cover[vtx];
+        }
+    }
+
+    /** @brief (u, v) of an edge given as a pair or as an object with end_points() */
+    template <typename Edge> auto _pd_end_points(const Edge& edge) {
+        if constexpr (requires { edge.end_points(); }) {
+            return edge.end_points();
+        } else {
+            return std::pair{edge.first, edge.second};
+        }
+    }
+}  // namespace
+
+/**
+ * @brief Minimum weighted vertex cover from a stream of edges
+ *
+ * min_vertex_cover_pd() makes a single pass over the edges and keeps only
+ * per-vertex state (cover and gap), so the edges need not be held in a
+ * graph: any input range works, e.g. a std::span over an edge array, or
+ * the chunked file readers of edge_stream.hpp for graphs larger than
+ * memory. The range is iterated exactly once. Vertex ids are not checked,
+ * as in min_vertex_cover_pd(); the file readers reject ids out of range.
+ *
+ * @tparam Edges Input range of edges: (u, v) pairs or objects with end_points()
+ * @tparam C1 Type of cover mapping (vertex -> bool), e.g. std::vector<bool>
+ *            or DenseBitset
+ * @tparam C2 Type of weight mapping (vertex -> weight)
+ * @param[in] edges the edges, consumed in one pass
+ * @param[in,out] cover vertex cover mapping (updated with solution)
+ * @param[in] weight vertex weight mapping
+ * @return auto total cost of the vertex cover
+ */
+template <typename Edges, typename C1, typename C2>
+auto min_vertex_cover_pd_stream(Edges&& edges, C1& cover, const C2& weight) {
+    using T = typename C2::value_type;
+
+    [[maybe_unused]] auto total_dual_cost = T(0);
+    auto total_primal_cost = T(0);
+    auto gap = weight;
+    for (auto&& edge : edges) {
+        auto [utx, vtx] = _pd_end_points(edge);
+        if (_pd_covered(cover, utx, vtx)) {
+            continue;
+        }
+        if (gap[utx] < gap[vtx]) {
+            std::swap(utx, vtx);
+        }
+        cover[vtx] = true;
+        total_dual_cost += gap[vtx];
+        total_primal_cost += weight[vtx];
+        gap[utx] -= gap[vtx];
+        gap[vtx] = T(0);
+    }
+
+    assert(total_dual_cost <= total_primal_cost);
+    assert(total_primal_cost <= 2 * total_dual_cost);
+    return total_primal_cost;
+}
+
 /**
  * @brief Minimum weighted vertex cover using primal-dual algorithm
  *
@@ -54,7 +121,8 @@
  * @enddot
  *
  * @tparam Graph Type of the graph, must provide edges() and edge iteration
- * @tparam C1 Type of cover mapping (vertex -> bool)
+ * @tparam C1 Type of cover mapping (vertex -> bool), e.g. std::vector<bool>
+ *            or DenseBitset
  * @tparam C2 Type of weight mapping (vertex -> weight)
  * @param[in] gra input graph
  * @param[in,out] cover vertex cover mapping (updated with solution)
@@ -63,29 +131,7 @@
  */
 template <typename Graph, typename C1, typename C2>
 auto min_vertex_cover_pd(const Graph& gra, C1& cover, const C2& weight) {
-    using T = typename C2::value_type;
-
-    [[maybe_unused]] auto total_dual_cost = T(0);
-    auto total_primal_cost = T(0);
-    auto gap = weight;
-    for (auto&& edge : gra.edges()) {
-        auto [utx, vtx] = edge.end_points();
-        if (cover[utx] || cover[vtx]) {
-            continue;
-        }
-        if (gap[utx] < gap[vtx]) {
-            std::swap(utx, vtx);
-        }
-        cover[vtx] = true;
-        total_dual_cost += gap[vtx];
-        total_primal_cost += weight[vtx];
-        gap[utx] -= gap[vtx];
-        gap[vtx] = T(0);
-    }
-
-    assert(total_dual_cost <= total_primal_cost);
-    assert(total_primal_cost <= 2 * total_dual_cost);
-    return total_primal_cost;
+    return min_vertex_cover_pd_stream(gra.edges(), cover, weight);
 }
 
 /**
@@ -129,7 +175,8 @@ auto min_vertex_cover_pd(const Graph& gra, C1& cover, const C2& weight) {
  * @enddot
  *
  * @tparam Graph Type of the graph, must provide vertex iteration
- * @tparam C1 Type of independent/dependent set mapping (vertex -> bool)
+ * @tparam C1 Type of independent/dependent set mapping (vertex -> bool),
+ *            e.g. std::vector<bool> or DenseBitset
  * @tparam C2 Type of weight mapping (vertex -> weight)
  * @param[in] gra input graph
  * @param[in,out] indset independent set mapping (updated with solution)
@@ -143,8 +190,12 @@ auto min_maximal_independant_set_pd(const Graph& gra, C1& indset, C1& dep, const
 
     auto cover = [&](const auto& utx) {
         dep[utx] = true;
-        for (auto&& vtx : gra[utx]) {
-            dep[vtx] = true;
+        if constexpr (requires { dep.set_all(gra[utx]); }) {
+            dep.set_all(gra[utx]);  // DenseBitset: one OR per word of neighbors
+        } else {
+            for (auto&& vtx : gra[utx]) {
+                dep[vtx] = true;
+            }
         }
     };
 
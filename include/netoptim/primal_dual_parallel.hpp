@@ -0,0 +1,357 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <ThreadPool.h>  // import ThreadPool
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dense_bitset.hpp"  // import DenseBitset
+
+/**
+ * @file primal_dual_parallel.hpp
+ * @brief Multi-threaded variants of the primal-dual algorithms
+ *
+ * min_vertex_cover_pd() pays for one uncovered edge at a time: the endpoint
+ * with the smaller gap (residual weight) becomes tight and the other loses
+ * the same amount. That is the local-ratio step of Bar-Yehuda and Even, and
+ * the 2-approximation only needs every edge to be paid for once, in any
+ * order. The variant here lets the threads of a ThreadPool pay for disjoint
+ * chunks of the edge list concurrently, with the gaps kept in atomics.
+ *
+ * min_maximal_independant_set_pd() walks the vertices in order. Its
+ * multi-threaded variant works in Luby-style rounds instead: every
+ * undecided vertex that beats all its undecided neighbors joins the set,
+ * and the neighbors of the winners drop out, until no vertex is undecided.
+ */
+
+/** @brief Cost of a primal-dual solution and the lower bound that certifies it */
+template <typename T> struct PrimalDualCost {
+    T primal{};  ///< cost of the solution found
+    T dual{};    ///< dual objective: a lower bound on the optimum
+};
+
+namespace {
+    /**
+     * @brief Pay for edge (utx, vtx) out of the atomic gaps
+     *
+     * The endpoint with the smaller gap is set to zero with a CAS, then the
+     * same amount is taken from the other one. If a concurrent payment left
+     * the other endpoint with less, it becomes tight instead and the
+     * difference is given back to the first one, so no gap goes negative
+     * and the edge is covered either way.
+     *
+     * @return true if the edge was uncovered (neither gap was zero)
+     */
+    template <typename T>
+    auto _pd_pay(std::vector<std::atomic<T>>& gap, uint32_t utx, uint32_t vtx) -> bool {
+        auto gu = gap[utx].load(std::memory_order_relaxed);
+        auto gv = gap[vtx].load(std::memory_order_relaxed);
+        while (true) {
+            if (gu == T(0) || gv == T(0)) {
+                return false;
+            }
+            if (gu < gv) {  // same tie-break as min_vertex_cover_pd()
+                std::swap(utx, vtx);
+                std::swap(gu, gv);
+            }
+            if (gap[vtx].compare_exchange_weak(gv, T(0))) {
+                break;
+            }
+            gu = gap[utx].load(std::memory_order_relaxed);
+        }
+        const auto paid = gv;
+        auto charge = std::min(paid, gu);
+        while (!gap[utx].compare_exchange_weak(gu, gu - charge)) {
+            charge = std::min(paid, gu);
+        }
+        if (charge < paid) {
+            gap[vtx].fetch_add(paid - charge);
+        }
+        return true;
+    }
+
+    /** @brief Run fn(chunk) for every chunk in [0, num_chunks), on pool if there is one */
+    template <typename Fn>
+    auto _for_each_chunk(ThreadPool* pool, size_t num_workers, size_t num_chunks, Fn&& fn)
+        -> void {
+        auto next = std::atomic<size_t>{0};
+        auto work = [&]() -> void {
+            for (auto idx = next++; idx < num_chunks; idx = next++) {
+                fn(idx);
+            }
+        };
+        if (pool == nullptr || num_chunks <= 1) {
+            work();
+            return;
+        }
+        auto futures = std::vector<std::future<void>>{};
+        futures.reserve(num_workers);
+        for (auto idx = size_t(0); idx != std::min(num_workers, num_chunks); ++idx) {
+            futures.push_back(pool->enqueue(work));
+        }
+        for (auto& fut : futures) {
+            fut.get();
+        }
+    }
+
+    /** @brief Fixed pseudo-random tie-breaker of a vertex id (splitmix64 finalizer) */
+    inline auto _mis_rank(uint64_t vtx) -> uint64_t {
+        vtx = (vtx ^ (vtx >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+        vtx = (vtx ^ (vtx >> 27U)) * 0x94d049bb133111ebULL;
+        return vtx ^ (vtx >> 31U);
+    }
+}  // namespace
+
+/**
+ * @brief Minimum weighted vertex cover, primal-dual, on several threads
+ *
+ * Same 2-approximation as min_vertex_cover_pd(): a payment for an edge
+ * (u, v) takes the same amount from gap[u] and gap[v], no vertex pays more
+ * than its weight, and the cover is the set of vertices whose gap reached
+ * zero. The dual y_uv is the sum of all payments made for (u, v), so
+ *
+ *     sum_{v in C} w_v = sum_{v in C} sum_{e at v} y_e <= 2 sum_e y_e <= 2 OPT.
+ *
+ * The edges are split into chunks that the workers take from a shared
+ * counter. A CAS that finds a gap changed retries, and a payment that
+ * briefly zeroes a gap before giving part of it back can make another edge
+ * look covered, so sweeps repeat until one finds every edge covered
+ * (usually the second one). The duals accumulate over the sweeps: an edge
+ * whose endpoint got part of its gap refunded can be paid for again in a
+ * later sweep. With one thread the first sweep makes the
+ * payments of min_vertex_cover_pd(), except that an endpoint whose gap is
+ * used up by a payment counts as covered at once.
+ *
+ * Vertices of weight zero start tight and join the cover for free.
+ *
+ * @tparam Graph Type of the graph; edges() must be a random-access range of
+ *         edges with end_points() giving dense vertex ids
+ * @tparam C1 Type of cover mapping (vertex -> bool)
+ * @tparam C2 Type of weight mapping (vertex -> weight), indexed by vertex id
+ * @param[in] gra input graph
+ * @param[in,out] cover vertex cover mapping (pre-covered vertices are kept
+ *                and not charged; updated with the solution)
+ * @param[in] weight vertex weight mapping
+ * @param[in] num_threads Number of worker threads (0 or 1: run sequentially)
+ * @return PrimalDualCost the cost of the cover and the dual lower bound
+ */
+template <typename Graph, typename C1, typename C2>
+auto min_vertex_cover_pd_parallel(const Graph& gra, C1& cover, const C2& weight,
+                                  size_t num_threads = std::thread::hardware_concurrency())
+    -> PrimalDualCost<typename C2::value_type> {
+    using T = typename C2::value_type;
+    constexpr auto chunk = size_t(1) << 16;
+
+    const auto num_nodes = std::size(weight);
+    auto gap = std::vector<std::atomic<T>>(num_nodes);
+    for (auto vtx = size_t(0); vtx != num_nodes; ++vtx) {
+        gap[vtx].store(cover[vtx] ? T(0) : weight[vtx], std::memory_order_relaxed);
+    }
+
+    auto&& edges = gra.edges();
+    const auto num_edges = static_cast<size_t>(std::size(edges));
+    const auto num_chunks = (num_edges + chunk - 1) / chunk;
+    auto next = std::atomic<size_t>{0};
+    auto self_loops = std::atomic<T>{T(0)};  // paid once, not by two endpoints
+    auto sweep = [&]() -> bool {
+        auto paid = false;
+        auto loop_paid = T(0);
+        for (auto idx = next++; idx < num_chunks; idx = next++) {
+            const auto last = std::min(num_edges, (idx + 1) * chunk);
+            for (auto pos = idx * chunk; pos != last; ++pos) {
+                const auto [utx, vtx] = edges[pos].end_points();
+                if (utx == vtx) {
+                    const auto amount = gap[utx].exchange(T(0));
+                    loop_paid += amount;
+                    paid = paid || amount != T(0);
+                    continue;
+                }
+                paid = _pd_pay(gap, static_cast<uint32_t>(utx), static_cast<uint32_t>(vtx))
+                       || paid;
+            }
+        }
+        self_loops.fetch_add(loop_paid);
+        return paid;
+    };
+
+    const auto num_workers = std::min(num_threads, num_chunks);
+    if (num_workers <= 1) {
+        while (sweep()) {
+            next = 0;
+        }
+    } else {
+        auto pool = ThreadPool(num_workers);
+        auto futures = std::vector<std::future<bool>>(num_workers);
+        auto paid = true;
+        while (paid) {
+            next = 0;
+            for (auto& fut : futures) {
+                fut = pool.enqueue(sweep);
+            }
+            paid = false;
+            for (auto& fut : futures) {
+                paid = fut.get() || paid;
+            }
+        }
+    }
+
+    // the sum of the payments counts every y_e twice, except on self-loops
+    auto result = PrimalDualCost<T>{};
+    auto payments = T(0);
+    for (auto vtx = size_t(0); vtx != num_nodes; ++vtx) {
+        if (cover[vtx]) {
+            continue;
+        }
+        const auto residual = gap[vtx].load(std::memory_order_relaxed);
+        payments += weight[vtx] - residual;
+        if (residual == T(0)) {
+            cover[vtx] = true;
+            result.primal += weight[vtx];
+        }
+    }
+    const auto loops = self_loops.load();
+    result.dual = (payments - loops) / 2 + loops;
+
+    assert(result.dual <= result.primal);
+    assert(result.primal <= 2 * result.dual);
+    return result;
+}
+
+/**
+ * @brief Minimum maximal independent set in parallel rounds
+ *
+ * Every round, each undecided vertex whose (weight, rank) is smaller than
+ * that of all its undecided neighbors joins the set; the winners of a round
+ * are pairwise non-adjacent, and their neighbors become dependent. The rank
+ * is a fixed hash of the vertex id, so ties between equal weights are broken
+ * the same way whatever the number of threads (the result is deterministic)
+ * and, as in Luby's algorithm, a constant fraction of the vertices is
+ * decided in each round on graphs with uniform weights.
+ *
+ * The set found is the one built by repeatedly taking the lightest undecided
+ * vertex, a greedy rule for the same objective as
+ * min_maximal_independant_set_pd(). Vertices already in indset are kept,
+ * with their neighbors made dependent first, and vertices already in dep are
+ * never selected; neither is charged. A vertex in both counts as dependent,
+ * as in the sequential version: it excludes none of its neighbors.
+ *
+ * @tparam Graph Type of the graph; gra[u] iterates the neighbors of vertex u
+ * @tparam C1 Type of independent/dependent set mapping (vertex -> bool)
+ * @tparam C2 Type of weight mapping (vertex -> weight), indexed by vertex id
+ * @param[in] gra input graph, vertices 0 .. size(weight) - 1
+ * @param[in,out] indset independent set mapping (updated with solution)
+ * @param[in,out] dep dependent set mapping (updated with solution)
+ * @param[in] weight vertex weight mapping
+ * @param[in] num_threads Number of worker threads (0 or 1: run sequentially)
+ * @return auto total weight of the vertices added to the independent set
+ */
+template <typename Graph, typename C1, typename C2>
+auto min_maximal_independant_set_pd_parallel(
+    const Graph& gra, C1& indset, C1& dep, const C2& weight,
+    size_t num_threads = std::thread::hardware_concurrency()) {
+    using T = typename C2::value_type;
+    constexpr auto chunk = size_t(1) << 12;
+
+    const auto num_nodes = static_cast<uint32_t>(std::size(weight));
+    const auto num_chunks = [](size_t count) { return (count + chunk - 1) / chunk; };
+    const auto num_workers = std::min(num_threads, num_chunks(num_nodes));
+    auto pool_storage = std::optional<ThreadPool>{};
+    if (num_workers > 1) {
+        pool_storage.emplace(num_workers);
+    }
+    auto* pool = pool_storage ? &*pool_storage : nullptr;
+
+    // decided: selected or dependent. Both bitsets are shared by the
+    // workers and only touched through atomic word operations.
+    auto selected = DenseBitset(num_nodes);
+    auto decided = DenseBitset(num_nodes);
+    for (auto utx = 0U; utx != num_nodes; ++utx) {
+        if (dep[utx]) {  // checked first, as in min_maximal_independant_set_pd()
+            decided.set(utx);
+        } else if (indset[utx]) {  // pre-defined independant
+            selected.set(utx);
+            decided.set(utx);
+            for (auto&& vtx : gra[utx]) {
+                decided.set(vtx);
+            }
+        }
+    }
+    auto undecided = [&](uint32_t utx) -> bool { return !decided.test_atomic(utx); };
+
+    auto beats = [&](uint32_t utx, uint32_t vtx) -> bool {
+        if (weight[utx] != weight[vtx]) {
+            return weight[utx] < weight[vtx];
+        }
+        const auto ru = _mis_rank(utx);
+        const auto rv = _mis_rank(vtx);
+        return ru != rv ? ru < rv : utx < vtx;
+    };
+
+    auto active = std::vector<uint32_t>(num_nodes);
+    std::iota(active.begin(), active.end(), 0U);
+    auto winners = std::vector<std::vector<uint32_t>>{};
+    auto losers = std::vector<std::vector<uint32_t>>{};
+    while (!active.empty()) {
+        // 1. local minima among the undecided vertices (the bitsets are read only)
+        const auto num_parts = num_chunks(active.size());
+        winners.resize(num_parts);
+        losers.resize(num_parts);
+        _for_each_chunk(pool, num_workers, num_parts, [&](size_t idx) {
+            winners[idx].clear();
+            losers[idx].clear();
+            const auto last = std::min(active.size(), (idx + 1) * chunk);
+            for (auto pos = idx * chunk; pos != last; ++pos) {
+                const auto utx = active[pos];
+                if (!undecided(utx)) {
+                    continue;
+                }
+                auto is_min = true;
+                for (auto&& vtx : gra[utx]) {
+                    if (vtx != utx && undecided(vtx) && !beats(utx, vtx)) {
+                        is_min = false;
+                        break;
+                    }
+                }
+                (is_min ? winners : losers)[idx].push_back(utx);
+            }
+        });
+
+        // 2. winners join the set, their neighbors drop out
+        _for_each_chunk(pool, num_workers, num_parts, [&](size_t idx) {
+            for (const auto utx : winners[idx]) {
+                selected.set_atomic(utx);
+                decided.set_atomic(utx);
+                for (auto&& vtx : gra[utx]) {
+                    decided.set_atomic(vtx);
+                }
+            }
+        });
+
+        active.clear();
+        for (auto idx = size_t(0); idx != num_parts; ++idx) {
+            active.insert(active.end(), losers[idx].begin(), losers[idx].end());
+        }
+    }
+
+    auto total_primal_cost = T(0);
+    for (auto utx = 0U; utx != num_nodes; ++utx) {
+        if (selected.test(utx) && !indset[utx]) {
+            indset[utx] = true;
+            total_primal_cost += weight[utx];
+        }
+        if (decided.test(utx)) {
+            dep[utx] = true;  // covered, as cover() marks it
+        }
+    }
+    return total_primal_cost;
+}
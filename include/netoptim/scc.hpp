@@ -0,0 +1,185 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"  // import CsrGraph
+
+/**
+ * @file scc.hpp
+ * @brief Strongly connected components of a CsrGraph
+ *
+ * Every cycle of a directed graph lies inside one strongly connected
+ * component (SCC), so cycle problems (minimum cycle ratio, negative cycle
+ * detection, ...) decompose into independent subproblems, one per SCC.
+ * Components with a single node and no self-loop contain no cycle and can
+ * be dropped altogether.
+ *
+ * The components are computed with an iterative version of Tarjan's
+ * algorithm (no recursion, so deep graphs cannot overflow the stack).
+ */
+
+/**
+ * @brief Result of strongly_connected_components()
+ *
+ * Components are numbered in reverse topological order of the condensation
+ * (Tarjan's order): every edge between two components goes from a higher
+ * to a lower component id.
+ */
+struct SccDecomposition {
+    uint32_t num_components{0};
+    std::vector<uint32_t> component{};  ///< component id of every node
+};
+
+/**
+ * @brief Compute the strongly connected components of a CsrGraph
+ *
+ * @tparam Edge Type of the edge payload
+ * @param[in] gra the graph
+ * @return SccDecomposition component id of every node
+ */
+template <typename Edge> auto strongly_connected_components(const CsrGraph<Edge>& gra)
+    -> SccDecomposition {
+    constexpr auto NIL = ~uint32_t{0};
+    const auto num_nodes = gra.num_nodes();
+    const auto offsets = gra.offsets();
+    const auto targets = gra.targets();
+
+    auto result = SccDecomposition{0, std::vector<uint32_t>(num_nodes, NIL)};
+    auto index = std::vector<uint32_t>(num_nodes, NIL);
+    auto lowlink = std::vector<uint32_t>(num_nodes, 0U);
+    auto stack = std::vector<uint32_t>{};
+    auto calls = std::vector<std::pair<uint32_t, uint32_t>>{};  // (node, next slot)
+    auto counter = 0U;
+
+    for (auto root = 0U; root != num_nodes; ++root) {
+        if (index[root] != NIL) {
+            continue;
+        }
+        calls.emplace_back(root, offsets[root]);
+        index[root] = lowlink[root] = counter++;
+        stack.push_back(root);
+        while (!calls.empty()) {
+            auto& [utx, slot] = calls.back();
+            if (slot != offsets[utx + 1]) {
+                const auto vtx = targets[slot++];
+                if (index[vtx] == NIL) {
+                    index[vtx] = lowlink[vtx] = counter++;
+                    stack.push_back(vtx);
+                    calls.emplace_back(vtx, offsets[vtx]);  // invalidates utx, slot
+                } else if (result.component[vtx] == NIL) {  // vtx is on the stack
+                    lowlink[utx] = std::min(lowlink[utx], index[vtx]);
+                }
+                continue;
+            }
+            const auto node = utx;
+            calls.pop_back();
+            if (!calls.empty()) {
+                const auto parent = calls.back().first;
+                lowlink[parent] = std::min(lowlink[parent], lowlink[node]);
+            }
+            if (lowlink[node] == index[node]) {
+                auto wtx = NIL;
+                do {
+                    wtx = stack.back();
+                    stack.pop_back();
+                    result.component[wtx] = result.num_components;
+                } while (wtx != node);
+                ++result.num_components;
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief A strongly connected component extracted as a graph of its own
+ *
+ * @tparam Edge Type of the edge payload
+ */
+template <typename Edge> struct SccSubgraph {
+    CsrGraph<Edge> graph{};            ///< induced subgraph with local node ids
+    std::vector<uint32_t> nodes{};     ///< global node id of every local node
+    std::vector<uint32_t> edge_ids{};  ///< global edge id of every local edge
+};
+
+/**
+ * @brief Split a CsrGraph into its nontrivial strongly connected components
+ *
+ * Edges between different components and components without any cycle (a
+ * single node without a self-loop) are dropped. Every cycle of gra is a
+ * cycle of exactly one returned subgraph.
+ *
+ * @tparam Edge Type of the edge payload
+ * @param[in] gra the graph
+ * @return the nontrivial components, largest (by edge count) first
+ */
+template <typename Edge> auto nontrivial_sccs(const CsrGraph<Edge>& gra)
+    -> std::vector<SccSubgraph<Edge>> {
+    const auto scc = strongly_connected_components(gra);
+    const auto offsets = gra.offsets();
+    const auto targets = gra.targets();
+    const auto edge_ids = gra.edge_ids();
+
+    auto num_edges = std::vector<uint32_t>(scc.num_components, 0U);
+    auto num_nodes = std::vector<uint32_t>(scc.num_components, 0U);
+    for (auto utx = 0U; utx != gra.num_nodes(); ++utx) {
+        const auto comp = scc.component[utx];
+        ++num_nodes[comp];
+        for (auto slot = offsets[utx]; slot != offsets[utx + 1]; ++slot) {
+            num_edges[comp] += static_cast<uint32_t>(scc.component[targets[slot]] == comp);
+        }
+    }
+
+    // an SCC has a cycle iff it has an internal edge (a self-loop at least)
+    constexpr auto NIL = ~uint32_t{0};
+    auto slot_of = std::vector<uint32_t>(scc.num_components, NIL);
+    auto parts = std::vector<SccSubgraph<Edge>>{};
+    for (auto comp = 0U; comp != scc.num_components; ++comp) {
+        if (num_edges[comp] != 0) {
+            slot_of[comp] = static_cast<uint32_t>(parts.size());
+            auto& part = parts.emplace_back();
+            part.nodes.reserve(num_nodes[comp]);
+            part.edge_ids.reserve(num_edges[comp]);
+        }
+    }
+
+    auto local = std::vector<uint32_t>(gra.num_nodes(), NIL);
+    for (auto utx = 0U; utx != gra.num_nodes(); ++utx) {
+        const auto idx = slot_of[scc.component[utx]];
+        if (idx != NIL) {
+            local[utx] = static_cast<uint32_t>(parts[idx].nodes.size());
+            parts[idx].nodes.push_back(utx);
+        }
+    }
+
+    auto ends = std::vector<std::vector<std::pair<uint32_t, uint32_t>>>(parts.size());
+    auto payloads = std::vector<std::vector<Edge>>(parts.size());
+    for (auto utx = 0U; utx != gra.num_nodes(); ++utx) {
+        const auto comp = scc.component[utx];
+        const auto idx = slot_of[comp];
+        if (idx == NIL) {
+            continue;
+        }
+        for (auto slot = offsets[utx]; slot != offsets[utx + 1]; ++slot) {
+            const auto vtx = targets[slot];
+            if (scc.component[vtx] == comp) {
+                ends[idx].emplace_back(local[utx], local[vtx]);
+                payloads[idx].push_back(gra.edge(edge_ids[slot]));
+                parts[idx].edge_ids.push_back(edge_ids[slot]);
+            }
+        }
+    }
+    for (auto idx = size_t(0); idx != parts.size(); ++idx) {
+        parts[idx].graph = CsrGraph<Edge>(static_cast<uint32_t>(parts[idx].nodes.size()),
+                                          ends[idx], std::move(payloads[idx]));
+    }
+
+    std::stable_sort(parts.begin(), parts.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.edge_ids.size() > rhs.edge_ids.size();
+    });
+    return parts;
+}
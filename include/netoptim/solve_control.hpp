@@ -0,0 +1,79 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <stop_token>
+#include <type_traits>
+
+/**
+ * @file solve_control.hpp
+ * @brief Cancellation, deadline and progress reporting for long solves
+ *
+ * max_parametric_until() takes a SolveControl: a std::stop_token to cancel
+ * the solve from another thread, a deadline, and a progress callback. The
+ * stop conditions are checked between Howard runs, and on a CsrGraph also
+ * every few thousand nodes inside a relaxation sweep. A stopped solve still
+ * returns the best ratio and cycle of the iterations completed so far (an
+ * anytime result), flagged with the reason it stopped.
+ */
+
+/** @brief Why a solve ended */
+enum class SolveStatus {
+    Converged,        ///< no cycle beats the ratio: it is optimal
+    MaxIters,         ///< the iteration limit was reached
+    Cancelled,        ///< a stop was requested through the stop token
+    DeadlineExpired,  ///< the deadline passed
+};
+
+/**
+ * @brief Stop conditions and progress callback of a solve
+ *
+ * @tparam T Numeric type for the parameter r
+ */
+template <typename T> struct SolveControl {
+    using clock = std::chrono::steady_clock;
+
+    /** @brief Cancels the solve when a stop is requested */
+    std::stop_token stop_token{};
+    /** @brief Stops the solve when passed (default: never) */
+    clock::time_point deadline{clock::time_point::max()};
+    /** @brief Called after every iteration that lowered r_opt, with (iteration, r_opt) */
+    std::function<void(size_t, const T&)> progress{};
+
+    /** @brief Reason to stop now (Cancelled or DeadlineExpired), or std::nullopt to go on */
+    auto check() const -> std::optional<SolveStatus> {
+        if (this->stop_token.stop_requested()) {
+            return SolveStatus::Cancelled;
+        }
+        if (this->deadline != clock::time_point::max() && clock::now() >= this->deadline) {
+            return SolveStatus::DeadlineExpired;
+        }
+        return std::nullopt;
+    }
+};
+
+/** @brief Placeholder for "no stop conditions": every check is compiled away */
+struct NoControl {};
+
+/**
+ * @brief Outcome of max_parametric_until()
+ *
+ * @tparam Cycle Type of the critical cycle
+ */
+template <typename Cycle> struct AnytimeResult {
+    Cycle cycle{};                               ///< best cycle so far (empty if r not lowered)
+    SolveStatus status{SolveStatus::Converged};  ///< why the solve ended
+    size_t iterations{0};                        ///< iterations that lowered r_opt
+
+    /** @brief True if the ratio is optimal (not just the best so far) */
+    auto converged() const -> bool { return this->status == SolveStatus::Converged; }
+};
+
+namespace {
+    /** @brief True if Control (possibly a reference) carries stop conditions */
+    template <typename Control>
+    constexpr auto _has_control = !std::is_same_v<std::remove_cvref_t<Control>, NoControl>;
+}  // namespace
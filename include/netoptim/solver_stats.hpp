@@ -0,0 +1,53 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @file solver_stats.hpp
+ * @brief Optional counters and timers for the parametric solvers
+ *
+ * max_parametric(), min_cycle_ratio() and NetworkOracle::assess_feas()
+ * accept an optional trailing SolverStats argument. When it is given, the
+ * solver adds its counters and phase timings to it; when it is omitted, the
+ * solver is instantiated with NoStats and all bookkeeping is removed at
+ * compile time (no counters, no clock reads).
+ *
+ * Counters accumulate, so one SolverStats can collect a whole job made of
+ * many calls.
+ */
+
+/** @brief Counters and phase timings of the parametric solvers */
+struct SolverStats {
+    using duration = std::chrono::steady_clock::duration;
+
+    size_t iterations{0};        ///< outer iterations (assess_feas: calls)
+    size_t howard_passes{0};     ///< relaxation passes (CSR finder only)
+    size_t edge_evaluations{0};  ///< calls of the edge weight function
+    size_t cycles{0};            ///< negative cycles enumerated
+    size_t improving_cycles{0};  ///< cycles that lowered r_min (assess_feas: cuts)
+    size_t certificate_hits{0};  ///< assess_feas: feasible by the kept potentials alone
+    duration howard_time{};      ///< Howard's method, including edge weight evaluation
+    duration cycle_time{};       ///< evaluating cycles (zero_cancel, cut construction)
+    duration total_time{};       ///< whole call
+};
+
+/** @brief Placeholder for "no statistics requested" */
+struct NoStats {};
+
+namespace {
+    /** @brief True if Stats (possibly a reference) requests statistics */
+    template <typename Stats>
+    constexpr auto _collects_stats = std::is_same_v<std::remove_cvref_t<Stats>, SolverStats>;
+
+    /** @brief Current time if statistics are collected, an empty tag otherwise */
+    template <typename Stats> auto _stats_now() {
+        if constexpr (_collects_stats<Stats>) {
+            return std::chrono::steady_clock::now();
+        } else {
+            return NoStats{};
+        }
+    }
+}  // namespace
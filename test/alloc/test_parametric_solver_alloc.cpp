@@ -0,0 +1,66 @@
+// -*- coding: utf-8 -*-
+/*!
+ * @file test_parametric_solver_alloc.cpp
+ * @brief Allocation count of ParametricSolver::solve()
+ *
+ * The count replaces the global operator new, which would affect every
+ * test linked into the same executable; this file is therefore built as
+ * its own test binary (see test/CMakeLists.txt).
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK
+
+#include <array>                           // for array
+#include <atomic>                          // for atomic
+#include <cstdint>                         // for uint32_t
+#include <cstdlib>                         // for malloc, free
+#include <netoptim/csr_graph.hpp>          // for CsrGraph
+#include <netoptim/parametric_solver.hpp>  // for ParametricSolver
+#include <new>                             // for bad_alloc
+#include <utility>                         // for pair
+#include <vector>                          // for vector
+
+#include "../source/random_graph.tpp"  // for create_random_graph, distance, zero_cancel
+
+namespace {
+
+    std::atomic<size_t> num_allocs{0};
+
+    using Edge = std::pair<double, double>;  // (cost, time)
+
+}  // namespace
+
+// count every allocation of this test binary
+auto operator new(std::size_t size) -> void* {
+    ++num_allocs;
+    if (auto* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+auto operator delete(void* ptr) noexcept -> void { std::free(ptr); }
+auto operator delete(void* ptr, std::size_t /*size*/) noexcept -> void { std::free(ptr); }
+
+TEST_CASE("Test ParametricSolver does not allocate after construction") {
+    const auto gra = create_random_graph<Edge>(200, 600, 11);
+    auto solver = ParametricSolver<CsrGraph<Edge>, double>(gra);
+
+    auto r_first = 100.0;
+    solver.solve(r_first, distance, zero_cancel);
+
+    const auto before = num_allocs.load();
+    auto results = std::array<double, 8>{};
+    for (auto& r : results) {
+        r = 100.0;
+        solver.solve(r, distance, zero_cancel);
+        solver.reset();
+    }
+    const auto allocs = num_allocs.load() - before;
+
+    CHECK_EQ(allocs, 0);
+    for (const auto r : results) {
+        CHECK_EQ(r, doctest::Approx(r_first));
+    }
+}
@@ -0,0 +1,70 @@
+// -*- coding: utf-8 -*-
+/*!
+ * @file random_graph.tpp
+ * @brief Random cost/time CsrGraph fixture shared by the parametric tests
+ *
+ * Included (not compiled on its own) by the tests of max_parametric(),
+ * ParametricSolver, SolveControl, SolverStats and the cycle ratio engines,
+ * and by bench_cycle_ratio. The values are drawn from std::mt19937 directly rather than through the
+ * std::*_distribution classes, whose output depends on the standard library:
+ * every toolchain sees the same graphs.
+ */
+
+#include <cstdint>                 // for uint32_t
+#include <netoptim/csr_graph.hpp>  // for CsrGraph
+#include <random>                  // for mt19937
+#include <utility>                 // for pair
+#include <vector>                  // for vector
+
+namespace {
+
+    /// Integer in [lo, hi] (the modulo bias is irrelevant here)
+    inline auto draw(std::mt19937& gen, int lo, int hi) -> int {
+        return lo + static_cast<int>(gen() % static_cast<uint32_t>(hi - lo + 1));
+    }
+
+    /**
+     * @brief A ring through all nodes plus random chords
+     *
+     * Every edge carries (cost, time) with cost in [-5, 20] and time in
+     * [min_time, max_time]; the ring makes sure there is a cycle.
+     *
+     * @tparam Edge pair type of the payload, e.g. std::pair<double, double>
+     */
+    template <typename Edge>
+    auto create_random_graph(uint32_t num_nodes, uint32_t num_chords, uint32_t seed,
+                             int max_time = 4, int min_time = 1) -> CsrGraph<Edge> {
+        auto gen = std::mt19937{seed};
+        auto ends = std::vector<std::pair<uint32_t, uint32_t>>{};
+        auto payloads = std::vector<Edge>{};
+        auto add = [&](uint32_t utx, uint32_t vtx) {
+            ends.emplace_back(utx, vtx);
+            payloads.emplace_back(draw(gen, -5, 20), draw(gen, min_time, max_time));
+        };
+        for (auto utx = 0U; utx != num_nodes; ++utx) {
+            add(utx, (utx + 1) % num_nodes);
+        }
+        for (auto idx = 0U; idx != num_chords; ++idx) {
+            const auto utx = static_cast<uint32_t>(gen() % num_nodes);
+            add(utx, static_cast<uint32_t>(gen() % num_nodes));
+        }
+        return {num_nodes, ends, std::move(payloads)};
+    }
+
+    /// Parametric weight cost - r * time of the minimum cycle ratio problem
+    const auto distance = [](const double& r, const auto& edge) -> double {
+        return edge.first - r * edge.second;
+    };
+
+    /// Ratio of a cycle, total cost / total time
+    const auto zero_cancel = [](const auto& cycle) -> double {
+        auto total_cost = 0.0;
+        auto total_time = 0.0;
+        for (const auto& edge : cycle) {
+            total_cost += edge.first;
+            total_time += edge.second;
+        }
+        return total_cost / total_time;
+    };
+
+}  // namespace
@@ -0,0 +1,118 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK
+
+#include <cstdint>                           // for uint32_t
+#include <netoptim/csr_graph.hpp>            // for CsrGraph
+#include <netoptim/cycle_ratio_engines.hpp>  // for min_cycle_ratio, select_cycle_ratio_engine
+#include <utility>                           // for pair
+#include <vector>                            // for vector
+
+#include "random_graph.tpp"  // for create_random_graph
+
+namespace {
+
+    using Edge = std::pair<int, int>;  // (cost, time)
+
+    auto solve(const CsrGraph<Edge>& gra, CycleRatioEngine engine) -> std::pair<double, double> {
+        const auto get_cost = [](const Edge& edge) -> double { return edge.first; };
+        const auto get_time = [](const Edge& edge) -> double { return edge.second; };
+        auto dist = std::vector<double>(gra.num_nodes(), 0.0);
+        auto r = 1000.0;
+        const auto cycle = min_cycle_ratio(gra, r, get_cost, get_time, dist, engine);
+        CHECK_FALSE(cycle.empty());
+        auto total_cost = 0.0;
+        auto total_time = 0.0;
+        for (const auto& edge : cycle) {
+            total_cost += edge.first;
+            total_time += edge.second;
+        }
+        return {r, total_cost / total_time};
+    }
+
+}  // namespace
+
+TEST_CASE("Test cycle ratio engines agree (uniform times)") {
+    const auto gra = create_random_graph<Edge>(40, 120, 42, 1);
+    const auto get_time = [](const Edge& edge) -> double { return edge.second; };
+    const auto [r_howard, c_howard] = solve(gra, CycleRatioEngine::Howard);
+    CHECK_EQ(c_howard, doctest::Approx(r_howard));
+    for (const auto engine : {CycleRatioEngine::Karp, CycleRatioEngine::YoungTarjanOrlin,
+                              CycleRatioEngine::Lawler}) {
+        REQUIRE_EQ(select_cycle_ratio_engine<double>(gra, get_time, engine), engine);
+        const auto [r, ratio] = solve(gra, engine);
+        CHECK_EQ(r, doctest::Approx(r_howard));
+        CHECK_EQ(ratio, doctest::Approx(r));  // the cycle attains the ratio
+    }
+}
+
+TEST_CASE("Test cycle ratio engines agree (uniform times other than one)") {
+    // Karp computes a minimum mean; the ratio divides it by the common time
+    const auto gra = create_random_graph<Edge>(40, 120, 42, 3, 3);
+    const auto get_time = [](const Edge& edge) -> double { return edge.second; };
+    REQUIRE_EQ(select_cycle_ratio_engine<double>(gra, get_time, CycleRatioEngine::Karp),
+               CycleRatioEngine::Karp);
+    const auto [r_howard, c_howard] = solve(gra, CycleRatioEngine::Howard);
+    const auto [r_karp, c_karp] = solve(gra, CycleRatioEngine::Karp);
+    CHECK_EQ(r_karp, doctest::Approx(r_howard));
+    CHECK_EQ(c_karp, doctest::Approx(r_karp));
+}
+
+TEST_CASE("Test cycle ratio engine fallback") {
+    const auto get_time = [](const Edge& edge) -> double { return edge.second; };
+    const auto uniform = create_random_graph<Edge>(20, 40, 42, 1);
+    const auto general = create_random_graph<Edge>(20, 40, 42, 5);
+    CHECK_EQ(select_cycle_ratio_engine<double>(uniform, get_time, CycleRatioEngine::Karp),
+             CycleRatioEngine::Karp);
+    CHECK_EQ(select_cycle_ratio_engine<double>(general, get_time, CycleRatioEngine::Karp),
+             CycleRatioEngine::Howard);
+    CHECK_EQ(select_cycle_ratio_engine<double>(general, get_time, CycleRatioEngine::Lawler),
+             CycleRatioEngine::Lawler);
+    CHECK_EQ(select_cycle_ratio_engine<int>(general, get_time, CycleRatioEngine::Lawler),
+             CycleRatioEngine::Howard);  // bisection needs a floating-point ratio
+
+    const auto zero_time = [](const Edge& edge) -> double { return edge.second - 1; };
+    for (const auto engine : {CycleRatioEngine::Karp, CycleRatioEngine::YoungTarjanOrlin,
+                              CycleRatioEngine::Lawler}) {
+        CHECK_EQ(select_cycle_ratio_engine<double>(uniform, zero_time, engine),
+                 CycleRatioEngine::Howard);
+    }
+}
+
+TEST_CASE("Test cycle ratio engines agree (general times)") {
+    // Karp does not apply here (it would fall back to Howard)
+    const auto gra = create_random_graph<Edge>(60, 200, 42, 5);
+    const auto get_time = [](const Edge& edge) -> double { return edge.second; };
+    const auto [r_howard, c_howard] = solve(gra, CycleRatioEngine::Howard);
+    for (const auto engine : {CycleRatioEngine::YoungTarjanOrlin, CycleRatioEngine::Lawler}) {
+        REQUIRE_EQ(select_cycle_ratio_engine<double>(gra, get_time, engine), engine);
+        const auto [r, ratio] = solve(gra, engine);
+        CHECK_EQ(r, doctest::Approx(r_howard));
+        CHECK_EQ(ratio, doctest::Approx(r));
+    }
+}
+
+TEST_CASE("Test cycle ratio engines on an acyclic graph") {
+    const auto ends = std::vector<std::pair<uint32_t, uint32_t>>{{0, 1}, {1, 2}, {0, 2}};
+    const auto gra = CsrGraph<Edge>(3, ends, {{1, 1}, {2, 1}, {3, 1}});
+    const auto get_cost = [](const Edge& edge) -> double { return edge.first; };
+    const auto get_time = [](const Edge& edge) -> double { return edge.second; };
+    for (const auto engine : {CycleRatioEngine::Howard, CycleRatioEngine::Karp,
+                              CycleRatioEngine::YoungTarjanOrlin, CycleRatioEngine::Lawler}) {
+        auto dist = std::vector<double>(3, 0.0);
+        auto r = 10.0;
+        CHECK(min_cycle_ratio(gra, r, get_cost, get_time, dist, engine).empty());
+        CHECK_EQ(r, 10.0);
+    }
+}
+
+TEST_CASE("Test cycle ratio engines agree (larger graph)") {
+    // large distances accumulate over the iterations; Howard must not stop at
+    // the previous critical cycle, whose weight is zero up to rounding
+    const auto gra = create_random_graph<Edge>(2000, 6000, 42, 10);
+    const auto [r_lawler, c_lawler] = solve(gra, CycleRatioEngine::Lawler);
+    for (const auto engine : {CycleRatioEngine::Howard, CycleRatioEngine::YoungTarjanOrlin}) {
+        const auto [r, ratio] = solve(gra, engine);
+        CHECK_EQ(r, doctest::Approx(r_lawler));
+        CHECK_EQ(ratio, doctest::Approx(r));
+    }
+}
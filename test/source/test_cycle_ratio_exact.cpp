@@ -0,0 +1,76 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK
+
+#include <cstdint>                             // for uint32_t
+#include <netoptim/csr_graph.hpp>              // for CsrGraph
+#include <netoptim/min_cycle_ratio.hpp>        // for min_cycle_ratio
+#include <netoptim/min_cycle_ratio_exact.hpp>  // for min_cycle_ratio_exact
+#include <py2cpp/fractions.hpp>                // for Fraction
+#include <random>                              // for mt19937
+#include <utility>                             // for pair
+#include <vector>                              // for vector
+
+namespace {
+
+    using Edge = std::pair<int, int>;  // (cost, time)
+
+    const auto get_cost = [](const Edge& edge) -> int { return edge.first; };
+    const auto get_time = [](const Edge& edge) -> int { return edge.second; };
+
+}  // namespace
+
+TEST_CASE("Test Cycle Ratio (exact)") {
+    const auto ends = std::vector<std::pair<uint32_t, uint32_t>>{{0, 1}, {0, 2}, {1, 0},
+                                                                 {1, 2}, {2, 1}, {2, 0}};
+    const auto gra = CsrGraph<Edge>(3, ends, {{5, 1}, {1, 1}, {1, 1}, {1, 1}, {1, 1}, {1, 1}});
+
+    auto r = fun::Fraction<int>(5);
+    const auto c = min_cycle_ratio_exact(gra, r, get_cost, get_time);
+    CHECK_FALSE(c.empty());
+    CHECK_EQ(r, fun::Fraction<int>(1, 1));
+}
+
+TEST_CASE("Test Cycle Ratio (exact) matches Fraction potentials") {
+    auto gen = std::mt19937{7};
+    auto node = std::uniform_int_distribution<uint32_t>{0, 29};
+    auto cost = std::uniform_int_distribution<int>{-5, 30};
+    auto time = std::uniform_int_distribution<int>{1, 7};
+    auto ends = std::vector<std::pair<uint32_t, uint32_t>>{};
+    auto payloads = std::vector<Edge>{};
+    for (auto utx = 0U; utx != 30; ++utx) {
+        ends.emplace_back(utx, (utx + 1) % 30);
+        payloads.emplace_back(cost(gen), time(gen));
+    }
+    for (auto idx = 0U; idx != 60; ++idx) {
+        ends.emplace_back(node(gen), node(gen));
+        payloads.emplace_back(cost(gen), time(gen));
+    }
+    const auto gra = CsrGraph<Edge>(30, ends, std::move(payloads));
+
+    auto dist = std::vector<fun::Fraction<int>>(gra.num_nodes(), fun::Fraction<int>(0));
+    auto r1 = fun::Fraction<int>(100);
+    min_cycle_ratio(gra, r1, get_cost, get_time, dist);
+
+    auto r2 = fun::Fraction<int>(100);
+    const auto c2 = min_cycle_ratio_exact(gra, r2, get_cost, get_time);
+    CHECK_EQ(r2, r1);
+    auto total_cost = 0;
+    auto total_time = 0;
+    for (const auto& edge : c2) {
+        total_cost += edge.first;
+        total_time += edge.second;
+    }
+    CHECK_EQ(fun::Fraction<int>(total_cost, total_time), r2);
+
+    auto r3 = fun::Fraction<int>(100);
+    min_cycle_ratio_exact<__int128>(gra, r3, get_cost, get_time);
+    CHECK_EQ(r3, r1);
+}
+
+TEST_CASE("Test Cycle Ratio (exact) keeps r0 when no cycle beats it") {
+    const auto ends = std::vector<std::pair<uint32_t, uint32_t>>{{0, 1}, {1, 0}};
+    const auto gra = CsrGraph<Edge>(2, ends, {{3, 1}, {4, 1}});
+    auto r = fun::Fraction<int>(3);
+    CHECK(min_cycle_ratio_exact(gra, r, get_cost, get_time).empty());
+    CHECK_EQ(r, fun::Fraction<int>(3));
+}
@@ -0,0 +1,68 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK
+
+#include <cstdint>                    // for uint64_t, uintptr_t
+#include <netoptim/dense_bitset.hpp>  // for DenseBitset
+#include <thread>                     // for thread
+#include <vector>                     // for vector
+
+TEST_CASE("Test DenseBitset") {
+    auto bits = DenseBitset(130);
+    CHECK_EQ(bits.size(), 130);
+    CHECK_EQ(bits.words().size(), 3);
+    CHECK_EQ(reinterpret_cast<std::uintptr_t>(bits.words().data()) % 64, 0);
+    CHECK_EQ(bits.count(), 0);
+
+    bits[0] = true;
+    bits.set(64);
+    bits[129] = true;
+    CHECK(bits[0]);
+    CHECK(bits.test(64));
+    CHECK_FALSE(bits[1]);
+    CHECK_EQ(bits.count(), 3);
+    CHECK_EQ(bits.words()[1], 1U);
+
+    CHECK(bits.test_any(1, 64));
+    CHECK(bits.test_any(129, 2));
+    CHECK_FALSE(bits.test_any(1, 63));
+
+    bits[0] = false;
+    bits.reset(64);
+    CHECK_EQ(bits.count(), 1);
+    bits.reset();
+    CHECK_EQ(bits.count(), 0);
+}
+
+TEST_CASE("Test DenseBitset set_all") {
+    auto bits = DenseBitset(200);
+    bits.set_all(std::vector<uint32_t>{3, 5, 63, 64, 70, 199, 1});  // word 0 twice
+    CHECK_EQ(bits.count(), 7);
+    for (const auto pos : {1U, 3U, 5U, 63U, 64U, 70U, 199U}) {
+        CHECK(bits.test(pos));
+    }
+    CHECK_FALSE(bits.test(0));
+    CHECK_FALSE(bits.test(128));
+    bits.set_all(std::vector<uint32_t>{});
+    CHECK_EQ(bits.count(), 7);
+}
+
+TEST_CASE("Test DenseBitset atomic updates") {
+    auto bits = DenseBitset(4096);
+    CHECK_FALSE(bits.set_atomic(7));
+    CHECK(bits.set_atomic(7));
+    CHECK(bits.test_atomic(7));
+
+    // four threads set interleaved bits of the same words
+    auto workers = std::vector<std::thread>{};
+    for (auto offset = 0U; offset != 4; ++offset) {
+        workers.emplace_back([&bits, offset] {
+            for (auto pos = offset; pos < 4096; pos += 4) {
+                bits.set_atomic(pos);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    CHECK_EQ(bits.count(), 4096);
+}
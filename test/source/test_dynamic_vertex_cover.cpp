@@ -0,0 +1,131 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK
+
+#include <cassert>                            // for assert
+#include <cstdint>                            // for uint32_t
+#include <netoptim/dynamic_vertex_cover.hpp>  // for DynamicVertexCover
+#include <netoptim/primal_dual.hpp>           // for min_vertex_cover_pd_stream
+#include <random>                             // for mt19937
+#include <utility>                            // for pair
+#include <vector>                             // for vector
+
+namespace {
+
+    using EdgeList = std::vector<std::pair<uint32_t, uint32_t>>;
+
+    /** @brief Check the cover and the dual certificate against the live edges */
+    auto check_state(const DynamicVertexCover<int>& dyn, const std::vector<int>& weight,
+                     const EdgeList& edges, const std::vector<size_t>& ids) -> void {
+        auto paid = std::vector<int>(weight.size(), 0);
+        auto dual = 0;
+        for (auto idx = size_t(0); idx != edges.size(); ++idx) {
+            const auto [utx, vtx] = edges[idx];
+            const auto covered = dyn.in_cover(utx) || dyn.in_cover(vtx);
+            CHECK(covered);
+            const auto y_e = dyn.dual(ids[idx]);
+            CHECK_GE(y_e, 0);
+            dual += y_e;
+            paid[utx] += y_e;
+            if (vtx != utx) {
+                paid[vtx] += y_e;
+            }
+        }
+        auto primal = 0;
+        for (auto vtx = 0U; vtx != weight.size(); ++vtx) {
+            CHECK_EQ(dyn.gap(vtx), weight[vtx] - paid[vtx]);
+            CHECK_GE(dyn.gap(vtx), 0);
+            if (dyn.in_cover(vtx)) {
+                CHECK_EQ(dyn.gap(vtx), 0);
+                primal += weight[vtx];
+            }
+        }
+        CHECK_EQ(dyn.num_edges(), edges.size());
+        CHECK_EQ(dyn.primal_cost(), primal);
+        CHECK_EQ(dyn.dual_cost(), dual);
+        CHECK_LE(dyn.primal_cost(), 2 * dyn.dual_cost());
+    }
+
+}  // namespace
+
+TEST_CASE("Test DynamicVertexCover - insertions match min_vertex_cover_pd") {
+    auto gen = std::mt19937{5};
+    auto node = std::uniform_int_distribution<uint32_t>{0, 499};
+    auto value = std::uniform_int_distribution<int>{1, 100};
+    auto weight = std::vector<int>(500);
+    for (auto& wt : weight) {
+        wt = value(gen);
+    }
+    auto edges = EdgeList{};
+    for (auto idx = 0; idx != 3000; ++idx) {
+        edges.emplace_back(node(gen), node(gen));
+    }
+
+    auto cover = std::vector<bool>(500, false);
+    const auto cost = min_vertex_cover_pd_stream(edges, cover, weight);
+
+    auto dyn = DynamicVertexCover<int>(weight);
+    auto ids = std::vector<size_t>{};
+    for (const auto& [utx, vtx] : edges) {
+        ids.push_back(dyn.insert_edge(utx, vtx));
+    }
+    CHECK_EQ(dyn.primal_cost(), cost);
+    CHECK_EQ(dyn.cover(), cover);
+    check_state(dyn, weight, edges, ids);
+}
+
+TEST_CASE("Test DynamicVertexCover - removal repairs the cover") {
+    // path 0 - 1 - 2: edge (0, 1) makes 0 tight, (1, 2) then makes 1 tight
+    auto dyn = DynamicVertexCover<int>({2, 5, 4});
+    const auto e01 = dyn.insert_edge(0, 1);
+    const auto e12 = dyn.insert_edge(1, 2);
+    CHECK(dyn.in_cover(0));
+    CHECK(dyn.in_cover(1));
+    CHECK_EQ(dyn.primal_cost(), 7);
+    CHECK_EQ(dyn.dual_cost(), 5);
+
+    // 0 loses its dual and leaves, 1 gets slack back and leaves too; (1, 2)
+    // is raised again and now makes 2 tight
+    dyn.remove_edge(e01);
+    CHECK_FALSE(dyn.in_cover(0));
+    CHECK_FALSE(dyn.in_cover(1));
+    CHECK(dyn.in_cover(2));
+    CHECK_EQ(dyn.dual(e12), 4);
+    CHECK_EQ(dyn.primal_cost(), 4);
+    CHECK_EQ(dyn.dual_cost(), 4);
+
+    dyn.remove_edge(e12);
+    CHECK_EQ(dyn.num_edges(), 0);
+    CHECK_EQ(dyn.primal_cost(), 0);
+    CHECK_EQ(dyn.dual_cost(), 0);
+    CHECK_EQ(dyn.gap(1), 5);
+}
+
+TEST_CASE("Test DynamicVertexCover - random insertions and deletions") {
+    auto gen = std::mt19937{17};
+    auto node = std::uniform_int_distribution<uint32_t>{0, 199};
+    auto value = std::uniform_int_distribution<int>{0, 50};  // some zero weights
+    auto weight = std::vector<int>(200);
+    for (auto& wt : weight) {
+        wt = value(gen);
+    }
+    auto dyn = DynamicVertexCover<int>(weight);
+    auto edges = EdgeList{};
+    auto ids = std::vector<size_t>{};
+    for (auto round = 0; round != 20; ++round) {
+        for (auto idx = 0; idx != 100; ++idx) {
+            const auto utx = node(gen);
+            const auto vtx = idx % 25 == 0 ? utx : node(gen);  // a few self-loops
+            edges.emplace_back(utx, vtx);
+            ids.push_back(dyn.insert_edge(utx, vtx));
+        }
+        for (auto idx = 0; idx != 80 && !edges.empty(); ++idx) {
+            const auto pos = std::uniform_int_distribution<size_t>{0, edges.size() - 1}(gen);
+            dyn.remove_edge(ids[pos]);
+            edges[pos] = edges.back();
+            edges.pop_back();
+            ids[pos] = ids.back();
+            ids.pop_back();
+        }
+        check_state(dyn, weight, edges, ids);
+    }
+}
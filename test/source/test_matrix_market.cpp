@@ -0,0 +1,211 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK
+
+#include <cmath>                         // for log, sqrt
+#include <cstdint>                       // for uint32_t
+#include <ios>                           // for ios_base
+#include <istream>                       // for istream
+#include <limits>                        // for infinity
+#include <list>                          // for list
+#include <map>                           // for map
+#include <netoptim/matrix_market.hpp>    // for read_matrix_market, scaling_graph
+#include <netoptim/optimal_scaling.hpp>  // for optimal_scaling
+#include <sstream>                       // for istringstream, stringbuf
+#include <stdexcept>                     // for runtime_error
+#include <string>                        // for string
+#include <unordered_map>                 // for unordered_map
+#include <utility>                       // for pair
+#include <vector>                        // for vector
+
+namespace {
+
+    using Entry = std::pair<double, double>;  // (a_ij, a_ji) in log scale
+
+    /** @brief Edge payloads keyed by (source, target) */
+    auto edge_map(const CsrGraph<Entry>& gra) -> std::map<std::pair<uint32_t, uint32_t>, Entry> {
+        auto result = std::map<std::pair<uint32_t, uint32_t>, Entry>{};
+        for (auto&& [utx, nbrs] : gra) {
+            for (auto&& [vtx, edge] : nbrs) {
+                result[{utx, vtx}] = edge;
+            }
+        }
+        return result;
+    }
+
+    /** @brief String buffer that refuses to seek, like a pipe */
+    class NoSeekBuf : public std::stringbuf {
+      public:
+        using std::stringbuf::stringbuf;
+
+      protected:
+        auto seekoff(off_type /*off*/, std::ios_base::seekdir /*dir*/,
+                     std::ios_base::openmode /*which*/) -> pos_type override {
+            return pos_type(off_type(-1));
+        }
+        auto seekpos(pos_type /*pos*/, std::ios_base::openmode /*which*/) -> pos_type override {
+            return pos_type(off_type(-1));
+        }
+    };
+
+}  // namespace
+
+TEST_CASE("Test read_matrix_market (symmetric)") {
+    auto input = std::istringstream{
+        "%%MatrixMarket matrix coordinate real symmetric\n"
+        "% comment lines are skipped\n"
+        "3 3 5\n"
+        "1 1 4.0\n"
+        "2 1 22.0\n"
+        "3 1 -10.0\n"
+        "3 2 10.0\n"
+        "3 3 0.0\n"};
+    const auto gra = read_matrix_market(input);
+    CHECK_EQ(gra.num_nodes(), 3);
+    CHECK_EQ(gra.num_edges(), 7);  // the zero is dropped, off-diagonals mirrored
+    const auto edges = edge_map(gra);
+    CHECK_EQ(edges.at({0, 0}).first, doctest::Approx(std::log(4.0)));
+    CHECK_EQ(edges.at({1, 0}).first, doctest::Approx(std::log(22.0)));
+    CHECK_EQ(edges.at({0, 1}).second, doctest::Approx(std::log(22.0)));
+    CHECK_EQ(edges.at({0, 2}).first, doctest::Approx(std::log(10.0)));
+    CHECK_EQ(edges.count({2, 2}), 0);
+}
+
+TEST_CASE("Test read_matrix_market (general) matches the hand-built graph") {
+    using CostGraph = std::unordered_map<uint32_t, std::list<std::pair<uint32_t, Entry>>>;
+
+    const auto log10 = std::log(10.0);
+    const auto log22 = std::log(22.0);
+    const auto log125 = std::log(125.0);
+    const auto hand = CostGraph{
+        {0, {{{1, {log22, log125}}, {2, {log10, log10}}}}},
+        {1, {{{0, {log125, log22}}, {2, {log10, log10}}}}},
+        {2, {{{0, {log10, log10}}, {1, {log10, log10}}}}},
+    };
+    auto input = std::istringstream{
+        "%%MatrixMarket matrix coordinate integer general\n"
+        "3 3 6\n"
+        "1 2 22\n1 3 10\n2 1 125\n2 3 10\n3 1 10\n3 2 10\n"};
+    const auto gra = read_matrix_market(input);
+    CHECK_EQ(gra.num_edges(), 6);
+
+    const auto get_cost = [](const Entry& edge) -> Entry { return edge; };
+    auto dist1 = std::unordered_map<uint32_t, double>{{0, 0.0}, {1, 0.0}, {2, 0.0}};
+    auto dist2 = std::vector<double>(3, 0.0);
+    const auto [pi1, psi1] = optimal_scaling(hand, get_cost, dist1);
+    const auto [pi2, psi2] = optimal_scaling(gra, get_cost, dist2);
+    CHECK_EQ(pi2 - psi2, doctest::Approx(pi1 - psi1));
+}
+
+TEST_CASE("Test scaling_graph with an unsymmetric pattern") {
+    // a_01 = 8, a_12 = 2, a_20 = 4, a_10 = 1: only (0, 1) has a partner
+    const auto triplets = std::vector<MatrixEntry>{
+        {0, 1, 8.0},
+        {1, 2, 2.0},
+        {2, 0, 4.0},
+        {1, 0, 1.0},
+    };
+    const auto gra = scaling_graph(3, triplets);
+    const auto inf = std::numeric_limits<double>::infinity();
+    const auto edges = edge_map(gra);
+    CHECK_EQ(gra.num_edges(), 6);
+    CHECK_EQ(edges.at({0, 1}).second, doctest::Approx(0.0));
+    CHECK_EQ(edges.at({1, 2}).second, -inf);
+    CHECK_EQ(edges.at({2, 1}).first, inf);
+    CHECK_EQ(edges.at({2, 1}).second, doctest::Approx(std::log(2.0)));
+
+    // both sides of every entry bind: the scaled entries of 0 -> 1 -> 2 -> 0
+    // multiply to 64, those of 0 <-> 1 to 8, so max >= 4 and min <= sqrt(8)
+    const auto get_cost = [](const Entry& edge) -> Entry { return edge; };
+    auto dist = std::vector<double>(3, 0.0);
+    const auto [pi, psi] = optimal_scaling(gra, get_cost, dist);
+    CHECK(pi - psi >= std::log(4.0) - std::log(8.0) / 2 - 1e-6);
+    for (const auto& [row, col, value] : triplets) {
+        const auto scaled = std::log(value) + dist[row] - dist[col];
+        CHECK(scaled <= pi + 1e-6);
+        CHECK(scaled >= psi - 1e-6);
+    }
+}
+
+TEST_CASE("Test scaling_graph sums duplicate entries") {
+    const auto triplets = std::vector<MatrixEntry>{
+        {0, 1, 2.0}, {1, 0, 4.0}, {0, 1, 3.0},  // a_01 = 2 + 3
+        {1, 2, 1.0}, {2, 1, 7.0}, {1, 2, -1.0},  // a_12 cancels out
+    };
+    const auto gra = scaling_graph(3, triplets);
+    const auto edges = edge_map(gra);
+    CHECK_EQ(gra.num_edges(), 4);  // 0 <-> 1 paired, 2 -> 1 alone plus its reverse
+    CHECK_EQ(edges.at({0, 1}).first, doctest::Approx(std::log(5.0)));
+    CHECK_EQ(edges.at({0, 1}).second, doctest::Approx(std::log(4.0)));
+    CHECK_EQ(edges.at({1, 2}).first, std::numeric_limits<double>::infinity());
+    CHECK_EQ(edges.at({1, 2}).second, doctest::Approx(std::log(7.0)));
+
+    // in a symmetric file the mirror of (2, 1) adds to an explicit (1, 2)
+    auto input = std::istringstream{
+        "%%MatrixMarket matrix coordinate real symmetric\n"
+        "2 2 3\n"
+        "2 1 3.0\n2 1 1.0\n1 2 6.0\n"};
+    const auto sym = read_matrix_market(input);
+    CHECK_EQ(sym.num_edges(), 2);
+    CHECK_EQ(edge_map(sym).at({0, 1}).first, doctest::Approx(std::log(10.0)));
+    CHECK_EQ(edge_map(sym).at({1, 0}).first, doctest::Approx(std::log(10.0)));
+}
+
+TEST_CASE("Test read_matrix_market sums complex and skew entries before the modulus") {
+    // a_12 = (3 + 4i) + (-3) = 4i; summing the moduli would give 5 + 3
+    const auto text = std::string{
+        "%%MatrixMarket matrix coordinate complex general\n"
+        "2 2 3\n"
+        "1 2 3.0 4.0\n1 2 -3.0 0.0\n2 1 1.0 1.0\n"};
+    auto seekable = std::istringstream{text};
+    const auto gra = read_matrix_market(seekable);
+    CHECK_EQ(edge_map(gra).at({0, 1}).first, doctest::Approx(std::log(4.0)));
+    CHECK_EQ(edge_map(gra).at({0, 1}).second, doctest::Approx(std::log(std::sqrt(2.0))));
+    auto buffer = NoSeekBuf{text};
+    auto piped = std::istream{&buffer};
+    CHECK(edge_map(read_matrix_market(piped)) == edge_map(gra));
+
+    // skew-symmetric: the mirror of a_21 = 3 is a_12 = -3, so a_12 = 5 - 3
+    auto skew = std::istringstream{
+        "%%MatrixMarket matrix coordinate real skew-symmetric\n"
+        "2 2 2\n"
+        "2 1 3.0\n1 2 5.0\n"};
+    const auto skew_edges = edge_map(read_matrix_market(skew));
+    CHECK_EQ(skew_edges.at({0, 1}).first, doctest::Approx(std::log(2.0)));
+    CHECK_EQ(skew_edges.at({1, 0}).first, doctest::Approx(std::log(2.0)));
+
+    // hermitian: the mirror of a_21 = 1 + 2i is a_12 = 1 - 2i, so a_12 = 2
+    auto hermitian = std::istringstream{
+        "%%MatrixMarket matrix coordinate complex hermitian\n"
+        "2 2 2\n"
+        "2 1 1.0 2.0\n1 2 1.0 2.0\n"};
+    const auto herm_edges = edge_map(read_matrix_market(hermitian));
+    CHECK_EQ(herm_edges.at({0, 1}).first, doctest::Approx(std::log(2.0)));
+    CHECK_EQ(herm_edges.at({1, 0}).first, doctest::Approx(std::log(2.0)));
+}
+
+TEST_CASE("Test read_matrix_market from a stream that cannot seek") {
+    const auto text = std::string{
+        "%%MatrixMarket matrix coordinate real general\n"
+        "3 3 5\n"
+        "1 2 8.0\n2 3 2.0\n3 1 4.0\n2 1 1.0\n3 3 5.0\n"};
+    auto seekable = std::istringstream{text};
+    auto buffer = NoSeekBuf{text};
+    auto piped = std::istream{&buffer};
+    const auto expected = read_matrix_market(seekable);
+    const auto gra = read_matrix_market(piped);
+    CHECK_EQ(gra.num_edges(), expected.num_edges());
+    CHECK(edge_map(gra) == edge_map(expected));
+}
+
+TEST_CASE("Test read_matrix_market rejects bad input") {
+    auto no_banner = std::istringstream{"3 3 0\n"};
+    CHECK_THROWS_AS(read_matrix_market(no_banner), std::runtime_error);
+    auto dense = std::istringstream{"%%MatrixMarket matrix array real general\n2 2\n"};
+    CHECK_THROWS_AS(read_matrix_market(dense), std::runtime_error);
+    auto rectangular
+        = std::istringstream{"%%MatrixMarket matrix coordinate real general\n2 3 0\n"};
+    CHECK_THROWS_AS(read_matrix_market(rectangular), std::runtime_error);
+    auto short_file
+        = std::istringstream{"%%MatrixMarket matrix coordinate real general\n2 2 2\n1 1 1.0\n"};
+    CHECK_THROWS_AS(read_matrix_market(short_file), std::runtime_error);
+}
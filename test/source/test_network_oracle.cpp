@@ -1,12 +1,19 @@
 // -*- coding: utf-8 -*-
 #include <doctest/doctest.h>
 
+#include <algorithm>
+#include <array>
 #include <list>
 #include <map>
 #include <memory>
+#include <netoptim/csr_graph.hpp>
 #include <netoptim/network_oracle.hpp>
+#include <netoptim/solver_stats.hpp>
+#include <span>
 #include <unordered_map>
 #include <utility>
+#include <valarray>
+#include <vector>
 
 namespace {
 
@@ -141,3 +148,208 @@ TEST_CASE("Test NetworkOracle gradient") {
     CHECK_EQ(f, doctest::Approx(3.0));
     CHECK_EQ(g, doctest::Approx(4.0));
 }
+
+TEST_CASE("Test NetworkOracle sparse gradient") {
+    auto gra = create_cycle_graph();
+
+    // h(edge, x) = value(edge) + x[source]; only one entry of the gradient is nonzero
+    struct SparseOracle {
+        std::map<std::pair<uint32_t, uint32_t>, double> values;
+
+        auto eval(const std::pair<uint32_t, uint32_t>& edge, const std::valarray<double>& x) const
+            -> double {
+            return values.at(edge) + x[edge.first];
+        }
+
+        auto grad_sparse(const std::pair<uint32_t, uint32_t>& edge,
+                         const std::valarray<double>& /*x*/) const
+            -> std::array<std::pair<size_t, double>, 1> {
+            return {{{edge.first, 1.0}}};
+        }
+    };
+
+    SparseOracle oracle;
+    oracle.values = {{{0, 1}, 1.0}, {{0, 2}, 0.0}, {{1, 2}, 1.0}, {{2, 0}, -3.0}};
+
+    std::unordered_map<uint32_t, double> dist{{0, 0.0}, {1, 0.0}, {2, 0.0}};
+    auto network = NetworkOracle(gra, dist, oracle);
+
+    const auto xval = std::valarray<double>(0.0, 1000);
+    const auto cut = network.assess_feas(xval);
+    REQUIRE(cut.has_value());
+
+    const auto& [g, f] = *cut;
+    // 2-edge cycle 0->2->0: each edge contributes -1 at its source node
+    CHECK_EQ(f, doctest::Approx(3.0));
+    CHECK_EQ(g.size(), 1000);
+    CHECK_EQ(g[0], doctest::Approx(-1.0));
+    CHECK_EQ(g[2], doctest::Approx(-1.0));
+    CHECK_EQ(g[1], doctest::Approx(0.0));
+    CHECK_EQ(std::abs(g).sum(), doctest::Approx(2.0));
+}
+
+TEST_CASE("Test NetworkOracle (csr)") {
+    using Edge = std::pair<double, double>;
+    const auto ends = std::vector<std::pair<uint32_t, uint32_t>>{{0, 1}, {1, 2}, {2, 0}, {0, 2}};
+    const auto gra = CsrGraph<Edge>(3, ends, {{1.0, 1.0}, {1.0, 1.0}, {-3.0, -1.0}, {0.0, 0.0}});
+
+    struct Oracle {
+        auto eval(const Edge& edge, double /*x*/) const -> double { return edge.first; }
+        auto grad(const Edge& edge, double /*x*/) const -> double { return edge.second; }
+    };
+
+    auto dist = std::vector<double>(3, 0.0);
+    auto network = NetworkOracle(gra, dist, Oracle{});
+    const auto cut = network.assess_feas(0.0);
+    REQUIRE(cut.has_value());
+    const auto& [g, f] = *cut;
+    CHECK_GT(f, 0.0);
+    CHECK_EQ(g, doctest::Approx(1.0));
+}
+
+TEST_CASE("Test NetworkOracle (csr) evaluates each edge once") {
+    using Edge = std::pair<double, double>;  // h = first + x * second
+    const auto ends = std::vector<std::pair<uint32_t, uint32_t>>{{0, 1}, {1, 2}, {2, 0}, {0, 2}};
+    const auto gra = CsrGraph<Edge>(3, ends, {{1.0, 0.0}, {1.0, 0.0}, {-1.0, 1.0}, {4.0, 0.0}});
+
+    struct Oracle {
+        size_t* evals;
+        auto eval(const Edge& edge, double x) const -> double {
+            ++*evals;
+            return edge.first + x * edge.second;
+        }
+        auto grad(const Edge& edge, double /*x*/) const -> double { return edge.second; }
+    };
+
+    auto evals = size_t{0};
+    auto dist = std::vector<double>(3, 0.0);
+    auto network = NetworkOracle(gra, dist, Oracle{&evals});
+    CHECK_FALSE(network.assess_feas(0.0).has_value());
+    CHECK_EQ(evals, gra.num_edges());
+
+    // only edge 2 depends on x: evaluate just that one again
+    const auto changed = std::vector<uint32_t>{2};
+    const auto cut = network.reassess_feas(-2.0, changed);
+    REQUIRE(cut.has_value());
+    CHECK_EQ(cut->first, doctest::Approx(-1.0));
+    CHECK_EQ(cut->second, doctest::Approx(1.0));
+    CHECK_EQ(evals, gra.num_edges() + 1);  // the cut reuses the buffered values
+}
+
+TEST_CASE("Test NetworkOracle (csr) batch eval_all") {
+    const auto ends = std::vector<std::pair<uint32_t, uint32_t>>{{0, 1}, {1, 2}, {2, 0}, {0, 2}};
+    const auto gra = CsrGraph<double>(3, ends, {1.0, 1.0, -3.0, 4.0});
+
+    struct Oracle {
+        size_t* evals;
+        size_t* batches;
+        auto eval(const double& edge, double x) const -> double {
+            ++*evals;
+            return edge + x;
+        }
+        auto eval_all(std::span<const double> edges, double x, std::span<double> out) const
+            -> void {
+            ++*batches;
+            for (auto idx = size_t(0); idx != edges.size(); ++idx) {
+                out[idx] = edges[idx] + x;
+            }
+        }
+        auto grad(const double& /*edge*/, double /*x*/) const -> double { return 1.0; }
+    };
+
+    auto evals = size_t{0};
+    auto batches = size_t{0};
+    auto dist = std::vector<double>(3, 0.0);
+    auto network = NetworkOracle(gra, dist, Oracle{&evals, &batches});
+    const auto cut = network.assess_feas(0.0);
+    REQUIRE(cut.has_value());
+    CHECK_EQ(cut->second, doctest::Approx(1.0));
+    CHECK_EQ(batches, 1);
+    CHECK_EQ(evals, 0);
+}
+
+TEST_CASE("Test NetworkOracle (csr) deepest cut and bundle") {
+    // two node-disjoint negative cycles: 0 <-> 1 (shallow) and 2 <-> 3 (deep)
+    const auto ends = std::vector<std::pair<uint32_t, uint32_t>>{{0, 1}, {1, 0}, {2, 3}, {3, 2}};
+    const auto gra = CsrGraph<double>(4, ends, {-1.0, 0.0, -5.0, 0.0});
+
+    struct Oracle {
+        auto eval(const double& edge, double /*x*/) const -> double { return edge; }
+        auto grad(const double& /*edge*/, double /*x*/) const -> double { return 1.0; }
+    };
+
+    auto dist = std::vector<double>(4, 0.0);
+    auto network = NetworkOracle(gra, dist, Oracle{});
+    const auto bundle = network.assess_feas_bundle(0.0);
+    REQUIRE_EQ(bundle.size(), 2);
+
+    std::fill(dist.begin(), dist.end(), 0.0);
+    network.set_cut_mode(CutMode::Deepest);
+    const auto cut = network.assess_feas(0.0);
+    REQUIRE(cut.has_value());
+    CHECK_EQ(cut->second, doctest::Approx(5.0));
+    CHECK_EQ(cut->first, doctest::Approx(-2.0));
+}
+
+TEST_CASE("Test NetworkOracle (csr) cycle cache") {
+    const auto ends = std::vector<std::pair<uint32_t, uint32_t>>{{0, 1}, {1, 2}, {2, 0}, {0, 2}};
+    const auto gra = CsrGraph<double>(3, ends, {1.0, 1.0, -1.0, 4.0});
+
+    struct Oracle {
+        auto eval(const double& edge, double x) const -> double { return edge + x; }
+        auto grad(const double& /*edge*/, double /*x*/) const -> double { return 1.0; }
+    };
+
+    auto dist = std::vector<double>(3, 0.0);
+    auto network = NetworkOracle(gra, dist, Oracle{});
+    network.set_cycle_cache(4);
+
+    // miss: Howard finds 0 -> 1 -> 2 -> 0 and caches it
+    const auto cut1 = network.assess_feas(-1.0);
+    REQUIRE(cut1.has_value());
+    CHECK_EQ(network.cycle_cache_hits(), 0);
+    CHECK_EQ(network.cycle_cache_misses(), 1);
+
+    // hit: the cached cycle is still negative at the new x
+    const auto cut2 = network.assess_feas(-0.5);
+    REQUIRE(cut2.has_value());
+    CHECK_EQ(cut2->second, doctest::Approx(0.5));
+    CHECK_EQ(cut2->first, doctest::Approx(-3.0));
+    CHECK_EQ(network.cycle_cache_hits(), 1);
+
+    // feasible: the cached cycle is not negative any more
+    CHECK_FALSE(network.assess_feas(0.0).has_value());
+    CHECK_EQ(network.cycle_cache_hits(), 1);
+    CHECK_EQ(network.cycle_cache_misses(), 2);
+}
+
+TEST_CASE("Test NetworkOracle (csr) skips Howard when the potentials certify feasibility") {
+    const auto ends = std::vector<std::pair<uint32_t, uint32_t>>{{0, 1}, {1, 0}};
+    const auto gra = CsrGraph<double>(2, ends, {-1.0, 2.0});
+
+    struct Oracle {
+        auto eval(const double& edge, double x) const -> double { return edge + x; }
+        auto grad(const double& /*edge*/, double /*x*/) const -> double { return 1.0; }
+    };
+
+    auto dist = std::vector<double>(2, 0.0);
+    auto network = NetworkOracle(gra, dist, Oracle{});
+
+    // zero potentials violate edge 0 -> 1: Howard runs and repairs them
+    auto stats = SolverStats{};
+    CHECK_FALSE(network.assess_feas(0.0, stats).has_value());
+    CHECK_EQ(stats.certificate_hits, 0);
+    const auto passes = stats.howard_passes;
+    CHECK_GT(passes, 0);
+
+    // x moved a little: the kept potentials are still a certificate
+    CHECK_FALSE(network.assess_feas(0.1, stats).has_value());
+    CHECK_EQ(stats.certificate_hits, 1);
+    CHECK_EQ(stats.howard_passes, passes);
+
+    // x moved a lot: the check fails and Howard finds the cycle
+    const auto cut = network.assess_feas(-1.0, stats);
+    REQUIRE(cut.has_value());
+    CHECK_EQ(cut->second, doctest::Approx(1.0));
+    CHECK_EQ(stats.certificate_hits, 1);
+}
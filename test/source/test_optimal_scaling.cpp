@@ -0,0 +1,243 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK
+
+#include <algorithm>                           // for max, min
+#include <cmath>                               // for log
+#include <cstdint>                             // for uint32_t
+#include <limits>                              // for infinity
+#include <list>                                // for list
+#include <netoptim/csr_graph.hpp>              // for CsrGraph, to_csr
+#include <netoptim/optimal_scaling.hpp>        // for optimal_scaling
+#include <netoptim/optimal_scaling_batch.hpp>  // for optimal_scaling_batch
+#include <netoptim/parametric_solver.hpp>      // for ParametricSolver
+#include <random>                              // for mt19937
+#include <unordered_map>                       // for unordered_map
+#include <utility>                             // for pair
+#include <vector>                              // for vector
+
+namespace {
+
+    using Entry = std::pair<double, double>;  // (a_ij, a_ji) in log scale
+
+    const auto get_cost = [](const Entry& edge) -> Entry { return edge; };
+
+    /** @brief Symmetric sparsity pattern: edge (i, j) carries (a_ij, a_ji) */
+    auto create_random_matrix(uint32_t num_nodes, uint32_t num_entries, uint32_t seed = 3)
+        -> CsrGraph<Entry> {
+        auto gen = std::mt19937{seed};
+        auto node = std::uniform_int_distribution<uint32_t>{0, num_nodes - 1};
+        auto value = std::uniform_real_distribution<double>{-5.0, 5.0};
+        auto ends = std::vector<std::pair<uint32_t, uint32_t>>{};
+        auto payloads = std::vector<Entry>{};
+        auto add = [&](uint32_t i, uint32_t j) {
+            const auto aij = value(gen);
+            const auto aji = value(gen);
+            ends.emplace_back(i, j);
+            payloads.emplace_back(aij, aji);
+            ends.emplace_back(j, i);
+            payloads.emplace_back(aji, aij);
+        };
+        for (auto utx = 0U; utx != num_nodes; ++utx) {
+            add(utx, (utx + 1) % num_nodes);
+        }
+        for (auto idx = num_nodes; idx < num_entries; ++idx) {
+            add(node(gen), node(gen));
+        }
+        return {num_nodes, ends, std::move(payloads)};
+    }
+
+    /** @brief Largest and smallest scaled entry a_ij + u_i - u_j */
+    auto scaled_range(const CsrGraph<Entry>& gra, const std::vector<double>& dist)
+        -> std::pair<double, double> {
+        auto hi = -std::numeric_limits<double>::infinity();
+        auto lo = std::numeric_limits<double>::infinity();
+        for (auto&& [utx, nbrs] : gra) {
+            for (auto&& [vtx, edge] : nbrs) {
+                const auto [aij, aji] = edge;
+                hi = std::max({hi, aij + dist[utx] - dist[vtx], aji + dist[vtx] - dist[utx]});
+                lo = std::min({lo, aij + dist[utx] - dist[vtx], aji + dist[vtx] - dist[utx]});
+            }
+        }
+        return {hi, lo};
+    }
+
+    /** @brief True if some u puts every scaled entry in [psi, pi] (Bellman-Ford) */
+    auto is_feasible(const CsrGraph<Entry>& gra, double pi, double psi) -> bool {
+        auto dist = std::vector<double>(gra.num_nodes(), 0.0);
+        for (auto pass = 0U; pass <= gra.num_nodes(); ++pass) {
+            auto changed = false;
+            for (auto&& [utx, nbrs] : gra) {
+                for (auto&& [vtx, edge] : nbrs) {
+                    const auto [aij, aji] = edge;
+                    const auto bound = dist[utx] + std::min(pi - aji, aij - psi);
+                    if (dist[vtx] > bound + 1e-12) {
+                        dist[vtx] = bound;
+                        changed = true;
+                    }
+                }
+            }
+            if (!changed) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Optimal pi - psi by bisection and Bellman-Ford only
+     *
+     * An answer independent of Howard and of any warm start: the smallest
+     * feasible pi of every psi is bisected, and pi(psi) - psi (convex) is
+     * minimized by a golden-section search.
+     */
+    auto reference_gap(const CsrGraph<Entry>& gra) -> double {
+        auto a_min = std::numeric_limits<double>::infinity();
+        auto a_max = -std::numeric_limits<double>::infinity();
+        for (const auto& [aij, aji] : gra.edges()) {
+            a_min = std::min({a_min, aij, aji});
+            a_max = std::max({a_max, aij, aji});
+        }
+        const auto span = a_max - a_min;
+        auto gap = [&](double psi) -> double {
+            auto lo = psi;
+            auto hi = psi + 3.0 * span + 1.0;
+            if (!is_feasible(gra, hi, psi)) {
+                return std::numeric_limits<double>::infinity();
+            }
+            for (auto step = 0; step != 60; ++step) {
+                const auto mid = (lo + hi) / 2;
+                (is_feasible(gra, mid, psi) ? hi : lo) = mid;
+            }
+            return hi - psi;
+        };
+        const auto inv_phi = (std::sqrt(5.0) - 1.0) / 2.0;
+        auto psi_lo = a_min - span;
+        auto psi_hi = a_max;
+        for (auto step = 0; step != 80; ++step) {
+            const auto psi_1 = psi_hi - inv_phi * (psi_hi - psi_lo);
+            const auto psi_2 = psi_lo + inv_phi * (psi_hi - psi_lo);
+            if (gap(psi_1) <= gap(psi_2)) {
+                psi_hi = psi_2;
+            } else {
+                psi_lo = psi_1;
+            }
+        }
+        return gap((psi_lo + psi_hi) / 2);
+    }
+
+}  // namespace
+
+TEST_CASE("Test optimal_scaling small") {
+    // b_01 + b_10 = 4 whatever the scaling, and b_00 = 1: the best is b_01 = b_10 = 2
+    const auto ends = std::vector<std::pair<uint32_t, uint32_t>>{{0, 1}, {1, 0}, {0, 0}};
+    const auto gra = CsrGraph<Entry>(2, ends, {{4.0, 0.0}, {0.0, 4.0}, {1.0, 1.0}});
+
+    auto dist = std::vector<double>(gra.num_nodes(), 0.0);
+    const auto [pi, psi] = optimal_scaling(gra, get_cost, dist);
+    CHECK_EQ(pi, doctest::Approx(2.0));
+    CHECK_EQ(psi, doctest::Approx(1.0));
+}
+
+TEST_CASE("Test optimal_scaling random sparse matrix") {
+    const auto gra = create_random_matrix(200, 600);
+
+    auto dist = std::vector<double>(gra.num_nodes(), 0.0);
+    const auto [hi0, lo0] = scaled_range(gra, dist);
+    const auto [pi, psi] = optimal_scaling(gra, get_cost, dist);
+
+    // the potentials achieve (pi, psi), which beats the unscaled matrix
+    const auto [hi, lo] = scaled_range(gra, dist);
+    CHECK_LE(hi, pi + 1e-6);
+    CHECK_GE(lo, psi - 1e-6);
+    CHECK_LT(pi - psi, hi0 - lo0);
+}
+
+TEST_CASE("Test optimal_scaling on an adjacency-list graph") {
+    using CostGraph = std::unordered_map<uint32_t, std::list<std::pair<uint32_t, Entry>>>;
+    const auto log10 = std::log(10.0);
+    const auto log22 = std::log(22.0);
+    const auto log125 = std::log(125.0);
+    const auto gra = CostGraph{
+        {0, {{1, {log22, log125}}, {2, {log10, log10}}}},
+        {1, {{0, {log125, log22}}, {2, {log10, log10}}}},
+        {2, {{0, {log10, log10}}, {1, {log10, log10}}}},
+    };
+
+    auto dist = std::unordered_map<uint32_t, double>{{0, 0.0}, {1, 0.0}, {2, 0.0}};
+    const auto [pi, psi] = optimal_scaling(gra, get_cost, dist);
+    const auto csr = to_csr(gra);
+    auto dist2 = std::vector<double>(csr.num_nodes(), 0.0);
+    const auto [pi2, psi2] = optimal_scaling(csr, get_cost, dist2);
+    CHECK_LE(psi, pi);
+    CHECK_EQ(pi - psi, doctest::Approx(pi2 - psi2));
+}
+
+TEST_CASE("Test optimal_scaling with a reused ParametricSolver") {
+    const auto large = create_random_matrix(200, 600);
+    const auto small = create_random_matrix(30, 90);
+
+    auto solver = ParametricSolver<CsrGraph<Entry>, double>(large);
+    for (const auto* gra : {&large, &small, &large}) {
+        solver.rebind(*gra);
+        const auto [pi, psi] = optimal_scaling(solver, get_cost);
+        auto dist = std::vector<double>(gra->num_nodes(), 0.0);
+        const auto [pi2, psi2] = optimal_scaling(*gra, get_cost, dist);
+        CHECK_EQ(pi - psi, doctest::Approx(pi2 - psi2));
+        const auto potentials = solver.dist();
+        const auto [hi, lo] = scaled_range(*gra, {potentials.begin(), potentials.end()});
+        CHECK_LE(hi, pi + 1e-6);
+        CHECK_GE(lo, psi - 1e-6);
+    }
+}
+
+TEST_CASE("Test optimal_scaling_batch") {
+    auto blocks = std::vector<CsrGraph<Entry>>{};
+    for (const auto num_nodes : {5U, 120U, 20U, 300U, 3U, 60U}) {
+        blocks.push_back(create_random_matrix(num_nodes, 3 * num_nodes));
+    }
+
+    const auto results = optimal_scaling_batch(blocks, get_cost, 4);
+    REQUIRE_EQ(results.size(), blocks.size());
+    for (auto idx = size_t(0); idx != blocks.size(); ++idx) {
+        auto dist = std::vector<double>(blocks[idx].num_nodes(), 0.0);
+        const auto [pi, psi] = optimal_scaling(blocks[idx], get_cost, dist);
+        CHECK_EQ(results[idx].pi - results[idx].psi, doctest::Approx(pi - psi));
+        CHECK_EQ(results[idx].dist.size(), blocks[idx].num_nodes());
+        const auto [hi, lo] = scaled_range(blocks[idx], results[idx].dist);
+        CHECK_LE(hi, results[idx].pi + 1e-6);
+        CHECK_GE(lo, results[idx].psi - 1e-6);
+    }
+
+    // sequential path gives the same answers
+    const auto serial = optimal_scaling_batch(blocks, get_cost, 1);
+    for (auto idx = size_t(0); idx != blocks.size(); ++idx) {
+        CHECK_EQ(serial[idx].pi, doctest::Approx(results[idx].pi));
+        CHECK_EQ(serial[idx].psi, doctest::Approx(results[idx].psi));
+    }
+}
+
+TEST_CASE("Test optimal_scaling against a Bellman-Ford reference") {
+    auto blocks = std::vector<CsrGraph<Entry>>{};
+    for (auto seed = 1U; seed != 41U; ++seed) {
+        const auto num_nodes = 4 + seed % 9;
+        blocks.push_back(create_random_matrix(num_nodes, 2 * num_nodes, seed));
+    }
+
+    // one solver rebound from block to block, as optimal_scaling_batch() does
+    auto solver = ParametricSolver<CsrGraph<Entry>, double>(blocks.front());
+    const auto batch = optimal_scaling_batch(blocks, get_cost, 4);
+    for (auto idx = size_t(0); idx != blocks.size(); ++idx) {
+        const auto& gra = blocks[idx];
+        const auto expected = reference_gap(gra);
+
+        auto dist = std::vector<double>(gra.num_nodes(), 0.0);
+        const auto [pi1, psi1] = optimal_scaling(gra, get_cost, dist);
+        CHECK_EQ(pi1 - psi1, doctest::Approx(expected).epsilon(1e-6));
+
+        solver.rebind(gra);
+        const auto [pi2, psi2] = optimal_scaling(solver, get_cost);
+        CHECK_EQ(pi2 - psi2, doctest::Approx(expected).epsilon(1e-6));
+
+        CHECK_EQ(batch[idx].pi - batch[idx].psi, doctest::Approx(expected).epsilon(1e-6));
+    }
+}
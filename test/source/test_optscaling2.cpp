@@ -1,6 +1,7 @@
 // -*- coding: utf-8 -*-
 #include <doctest/doctest.h>
 
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <limits>
@@ -99,3 +100,37 @@ TEST_CASE("Test OptScalingOracle operator()") {
     const auto [cut, shrunk] = omega(x, gamma);
     CHECK(shrunk);
 }
+
+TEST_CASE("Test OptScalingOracle with fixed-size std::array") {
+    using CostGraph
+        = std::unordered_map<uint32_t, std::list<std::pair<uint32_t, std::pair<double, double>>>>;
+    using Vec = std::array<double, 2>;
+
+    CostGraph gra{
+        {0, {{{1, {4.0, 4.0}}, {2, {1.0, 1.0}}}}},
+        {1, {{{0, {4.0, 4.0}}, {2, {4.0, 4.0}}}}},
+        {2, {{{0, {1.0, 1.0}}, {1, {4.0, 4.0}}}}},
+    };
+
+    auto get_cost = [](const std::pair<double, double>& edge_data) -> std::pair<double, double> {
+        return edge_data;
+    };
+    using GetCost = decltype(get_cost);
+    using Dist = std::unordered_map<uint32_t, double>;
+
+    // same cut as with std::valarray, accumulated without any gradient vector
+    auto dist1 = Dist{{0, 0.0}, {1, 0.0}, {2, 0.0}};
+    auto omega1 = OptScalingOracle(gra, dist1, get_cost);
+    auto gamma1 = std::numeric_limits<double>::infinity();
+    const auto [cut1, shrunk1] = omega1.assess_optim(std::valarray<double>{0.0, 0.0}, gamma1);
+
+    auto dist2 = Dist{{0, 0.0}, {1, 0.0}, {2, 0.0}};
+    auto omega2 = OptScalingOracle<CostGraph, Dist, GetCost, Vec>(gra, dist2, get_cost);
+    auto gamma2 = std::numeric_limits<double>::infinity();
+    const auto [cut2, shrunk2] = omega2.assess_optim(Vec{0.0, 0.0}, gamma2);
+
+    CHECK_EQ(shrunk2, shrunk1);
+    CHECK_EQ(cut2.second, doctest::Approx(cut1.second));
+    CHECK_EQ(cut2.first[0], doctest::Approx(cut1.first[0]));
+    CHECK_EQ(cut2.first[1], doctest::Approx(cut1.first[1]));
+}
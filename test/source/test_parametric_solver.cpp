@@ -0,0 +1,77 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK
+
+#include <cstdint>                         // for uint32_t
+#include <netoptim/csr_graph.hpp>          // for CsrGraph
+#include <netoptim/min_cycle_ratio.hpp>    // for min_cycle_ratio
+#include <netoptim/parametric_solver.hpp>  // for ParametricSolver
+#include <utility>                         // for pair
+#include <vector>                          // for vector
+
+#include "random_graph.tpp"  // for create_random_graph, distance, zero_cancel
+
+namespace {
+
+    using Edge = std::pair<double, double>;  // (cost, time)
+
+}  // namespace
+
+TEST_CASE("Test ParametricSolver matches min_cycle_ratio") {
+    const auto gra = create_random_graph<Edge>(50, 150, 11);
+    const auto get_cost = [](const Edge& edge) -> double { return edge.first; };
+    const auto get_time = [](const Edge& edge) -> double { return edge.second; };
+
+    auto dist = std::vector<double>(gra.num_nodes(), 0.0);
+    auto r1 = 100.0;
+    min_cycle_ratio(gra, r1, get_cost, get_time, dist);
+
+    auto solver = ParametricSolver<CsrGraph<Edge>, double>(gra);
+    auto r2 = 100.0;
+    const auto cycle = solver.solve(r2, distance, zero_cancel);
+    CHECK_FALSE(cycle.empty());
+    CHECK_EQ(r2, doctest::Approx(r1));
+    CHECK_EQ(zero_cancel(solver.cycle()), doctest::Approx(r2));
+}
+
+TEST_CASE("Test ParametricSolver rebind") {
+    const auto large = create_random_graph<Edge>(80, 240, 11);
+    const auto small = create_random_graph<Edge>(20, 40, 11);
+
+    auto solver = ParametricSolver<CsrGraph<Edge>, double>(large);
+    auto r_large = 100.0;
+    solver.solve(r_large, distance, zero_cancel);
+
+    for (const auto* gra : {&small, &large}) {
+        solver.rebind(*gra);
+        CHECK_EQ(solver.dist().size(), gra->num_nodes());
+        auto r1 = 100.0;
+        solver.solve(r1, distance, zero_cancel);
+        auto fresh = ParametricSolver<CsrGraph<Edge>, double>(*gra);
+        auto r2 = 100.0;
+        fresh.solve(r2, distance, zero_cancel);
+        CHECK_EQ(r1, doctest::Approx(r2));
+    }
+}
+
+TEST_CASE("Test ParametricSolver against a cold min_cycle_ratio") {
+    const auto get_cost = [](const Edge& edge) -> double { return edge.first; };
+    const auto get_time = [](const Edge& edge) -> double { return edge.second; };
+
+    auto failures = 0;
+    for (auto seed = 0U; seed != 500U; ++seed) {
+        const auto num_nodes = 5 + seed % 16;
+        const auto gra = create_random_graph<Edge>(num_nodes, 2 * num_nodes, seed);
+
+        auto dist = std::vector<double>(gra.num_nodes(), 0.0);
+        auto r1 = 100.0;
+        min_cycle_ratio(gra, r1, get_cost, get_time, dist);
+
+        auto solver = ParametricSolver<CsrGraph<Edge>, double>(gra);
+        auto r2 = 100.0;
+        solver.solve(r2, distance, zero_cancel);
+        if (r2 != doctest::Approx(r1)) {
+            ++failures;
+        }
+    }
+    CHECK_EQ(failures, 0);
+}
@@ -0,0 +1,99 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK
+
+#include <cstdint>                          // for uint32_t
+#include <list>                             // for list
+#include <netoptim/csr_graph.hpp>           // for to_csr
+#include <netoptim/min_cycle_ratio.hpp>     // for min_cycle_ratio_soa
+#include <netoptim/parametric_weights.hpp>  // for ParametricWeights
+#include <unordered_map>                    // for unordered_map
+#include <utility>                          // for pair
+#include <vector>                           // for vector
+
+TEST_CASE("Test parametric_weight_kernel") {
+    // odd length so that the vector body and the scalar tail both run
+    const auto n = size_t(19);
+    auto cost = std::vector<double>(n);
+    auto time = std::vector<double>(n);
+    for (auto i = size_t(0); i != n; ++i) {
+        cost[i] = 0.5 * double(i) - 3.0;
+        time[i] = 1.0 + double(i % 3);
+    }
+    auto out = std::vector<double>(n);
+    parametric_weight_kernel(cost.data(), time.data(), 1.25, out.data(), n);
+    for (auto i = size_t(0); i != n; ++i) {
+        CHECK_EQ(out[i], doctest::Approx(cost[i] - 1.25 * time[i]));
+    }
+
+    auto iout = std::vector<int>(3);
+    const auto icost = std::vector<int>{5, 1, 2};
+    const auto itime = std::vector<int>{1, 2, 3};
+    parametric_weight_kernel(icost.data(), itime.data(), 2, iout.data(), 3);
+    CHECK_EQ(iout[0], 3);
+    CHECK_EQ(iout[1], -3);
+    CHECK_EQ(iout[2], -4);
+}
+
+TEST_CASE("Test parametric_weight_kernel (SIMD lanes)") {
+    MESSAGE("parametric_weight_kernel lanes: " << parametric_weight_lanes);
+#ifdef NETOPTIM_SIMD
+    CHECK_GT(parametric_weight_lanes, 1);  // ENABLE_SIMD must reach the vector kernel
+#endif
+    // every tail length of the 8- and 4-lane bodies
+    for (auto n = size_t(0); n != 2 * parametric_weight_lanes + 9; ++n) {
+        auto cost = std::vector<double>(n);
+        auto time = std::vector<double>(n);
+        for (auto i = size_t(0); i != n; ++i) {
+            cost[i] = double(i) - 2.5;
+            time[i] = 0.5 + double(i % 5);
+        }
+        auto out = std::vector<double>(n + 1, -7.0);  // the kernel must not write past n
+        parametric_weight_kernel(cost.data(), time.data(), -0.75, out.data(), n);
+        for (auto i = size_t(0); i != n; ++i) {
+            CHECK_EQ(out[i], doctest::Approx(cost[i] + 0.75 * time[i]));
+        }
+        CHECK_EQ(out[n], -7.0);
+    }
+}
+
+TEST_CASE("Test ParametricWeights") {
+    using Edge = std::pair<int, int>;
+    const auto edges = std::vector<Edge>{{4, 1}, {1, 2}, {6, 3}};
+    auto weights = ParametricWeights<double>(std::span<const Edge>(edges),
+                                             [](const Edge& e) { return e.first; },
+                                             [](const Edge& e) { return e.second; });
+    weights.update(2.0);
+    CHECK_EQ(weights[0], doctest::Approx(2.0));
+    CHECK_EQ(weights[1], doctest::Approx(-3.0));
+    CHECK_EQ(weights[2], doctest::Approx(0.0));
+
+    const auto cycle = std::vector<uint32_t>{0, 2};
+    CHECK_EQ(weights.ratio(cycle), doctest::Approx(2.5));
+}
+
+TEST_CASE("Test Cycle Ratio (soa) matches min_cycle_ratio") {
+    using Graph = std::unordered_map<uint32_t, std::list<std::pair<uint32_t, std::pair<int, int>>>>;
+    // (cost, time) per edge
+    const auto gra = to_csr(Graph{
+        {0, {{1, {5, 1}}, {2, {1, 2}}}},
+        {1, {{0, {1, 1}}, {2, {3, 1}}}},
+        {2, {{1, {1, 3}}, {0, {2, 1}}}},
+        {3, {{0, {1, 1}}}},
+    });
+
+    const auto get_cost = [](const std::pair<int, int>& e) -> double { return e.first; };
+    const auto get_time = [](const std::pair<int, int>& e) -> double { return e.second; };
+
+    auto dist1 = std::vector<double>(gra.num_nodes(), 0.0);
+    auto r1 = 100.0;
+    const auto c1 = min_cycle_ratio(gra, r1, get_cost, get_time, dist1);
+
+    auto dist2 = std::vector<double>(gra.num_nodes(), 0.0);
+    auto r2 = 100.0;
+    const auto c2 = min_cycle_ratio_soa(gra, r2, get_cost, get_time, dist2);
+
+    CHECK_FALSE(c2.empty());
+    CHECK_EQ(r2, doctest::Approx(r1));
+    CHECK_EQ(r2, doctest::Approx(0.5));
+    CHECK_EQ(c2.size(), c1.size());
+}
@@ -3,7 +3,15 @@
 
 #include <cassert>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <netoptim/dense_bitset.hpp>
+#include <netoptim/edge_stream.hpp>
 #include <netoptim/primal_dual.hpp>
+#include <netoptim/primal_dual_parallel.hpp>
+#include <random>
+#include <sstream>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -68,6 +76,25 @@ namespace {
         std::vector<std::vector<uint32_t>> _adj;
     };
 
+    auto create_random_graph(uint32_t num_nodes, uint32_t num_edges) -> PdGraph {
+        auto gen = std::mt19937{7};
+        auto edge_list = std::vector<std::pair<uint32_t, uint32_t>>{};
+        for (auto idx = 0U; idx != num_edges; ++idx) {
+            const auto utx = static_cast<uint32_t>(gen() % num_nodes);
+            edge_list.emplace_back(utx, static_cast<uint32_t>(gen() % num_nodes));
+        }
+        return {num_nodes, std::move(edge_list)};
+    }
+
+    auto random_weights(uint32_t num_nodes) -> std::vector<int> {
+        auto gen = std::mt19937{11};
+        auto weight = std::vector<int>(num_nodes);
+        for (auto& wt : weight) {
+            wt = 1 + static_cast<int>(gen() % 100);
+        }
+        return weight;
+    }
+
 }  // namespace
 
 // ============================================================
@@ -151,6 +178,133 @@ TEST_CASE("Test Min Vertex Cover - Pre-covered Node") {
     CHECK_EQ(cost, 0);
 }
 
+TEST_CASE("Test Min Vertex Cover - DenseBitset") {
+    const auto gra = create_random_graph(2000, 20000);
+    const auto weight = random_weights(2000);
+
+    auto cover0 = std::vector<bool>(2000, false);
+    const auto cost0 = min_vertex_cover_pd(gra, cover0, weight);
+    auto cover1 = DenseBitset(2000);
+    const auto cost1 = min_vertex_cover_pd(gra, cover1, weight);
+    CHECK_EQ(cost1, cost0);
+    auto count0 = size_t(0);
+    for (auto vtx = 0U; vtx != 2000; ++vtx) {
+        CHECK_EQ(cover1[vtx], cover0[vtx]);
+        count0 += cover0[vtx] ? 1 : 0;
+    }
+    CHECK_EQ(cover1.count(), count0);
+
+    auto indset = DenseBitset(2000);
+    auto dep = DenseBitset(2000);
+    auto indset0 = std::vector<bool>(2000, false);
+    auto dep0 = std::vector<bool>(2000, false);
+    CHECK_EQ(min_maximal_independant_set_pd(gra, indset, dep, weight),
+             min_maximal_independant_set_pd(gra, indset0, dep0, weight));
+    CHECK_EQ(dep.count(), 2000);
+    for (auto vtx = 0U; vtx != 2000; ++vtx) {
+        CHECK_EQ(indset[vtx], indset0[vtx]);
+    }
+}
+
+TEST_CASE("Test Min Vertex Cover - Edge Stream") {
+    auto edge_list = std::vector<std::pair<uint32_t, uint32_t>>{};
+    for (const auto& edge : create_random_graph(2000, 20000).edges()) {
+        edge_list.push_back(edge.end_points());
+    }
+    const auto gra = PdGraph(2000, edge_list);
+    const auto weight = random_weights(2000);
+    auto cover0 = std::vector<bool>(2000, false);
+    const auto cost0 = min_vertex_cover_pd(gra, cover0, weight);
+
+    auto cover1 = std::vector<bool>(2000, false);
+    CHECK_EQ(min_vertex_cover_pd_stream(edge_list, cover1, weight), cost0);
+    CHECK_EQ(cover1, cover0);
+
+    auto text = std::stringstream{};
+    text << "# u v weight\n\n";
+    for (const auto& [utx, vtx] : edge_list) {
+        text << utx << ' ' << vtx << " 1.5\n";
+    }
+    auto text_edges = TextEdgeReader(text, 2000, 1000);
+    auto cover2 = std::vector<bool>(2000, false);
+    CHECK_EQ(min_vertex_cover_pd_stream(text_edges, cover2, weight), cost0);
+    CHECK_EQ(cover2, cover0);
+
+    const auto path = std::filesystem::temp_directory_path() / "netoptim_edge_stream.bin";
+    {
+        auto file = std::ofstream{path, std::ios::binary};
+        file.write(reinterpret_cast<const char*>(edge_list.data()),
+                   static_cast<std::streamsize>(edge_list.size() * sizeof(StreamEdge)));
+    }
+    auto binary_edges = BinaryEdgeReader(path, 2000, 999);  // last chunk partly filled
+    auto cover3 = DenseBitset(2000);
+    CHECK_EQ(min_vertex_cover_pd_stream(binary_edges, cover3, weight), cost0);
+    for (auto vtx = 0U; vtx != 2000; ++vtx) {
+        CHECK_EQ(cover3[vtx], cover0[vtx]);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Test Min Vertex Cover - Edge Stream, Bad Input") {
+    auto weight = std::vector<int>{1, 2, 3};
+    auto cover = std::vector<bool>(3, false);
+    auto bad = std::istringstream{"0 1\n1 x\n"};
+    auto edges = TextEdgeReader(bad, 3);
+    CHECK_THROWS_AS(min_vertex_cover_pd_stream(edges, cover, weight), std::runtime_error);
+    CHECK_THROWS_AS(BinaryEdgeReader("/nonexistent/edges.bin", 3), std::runtime_error);
+
+    // the readers reject vertex ids not smaller than num_nodes
+    auto out_of_range = std::istringstream{"0 1\n1 3\n"};
+    auto far_edges = TextEdgeReader(out_of_range, 3);
+    cover.assign(3, false);
+    CHECK_THROWS_AS(min_vertex_cover_pd_stream(far_edges, cover, weight), std::runtime_error);
+    const auto path = std::filesystem::temp_directory_path() / "netoptim_edge_stream_bad.bin";
+    {
+        const auto far = std::vector<StreamEdge>{{0, 1}, {7, 0}};
+        auto file = std::ofstream{path, std::ios::binary};
+        file.write(reinterpret_cast<const char*>(far.data()),
+                   static_cast<std::streamsize>(far.size() * sizeof(StreamEdge)));
+    }
+    auto far_binary = BinaryEdgeReader(path, 3);
+    cover.assign(3, false);
+    CHECK_THROWS_AS(min_vertex_cover_pd_stream(far_binary, cover, weight), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Test Min Vertex Cover - Parallel") {
+    const auto gra = create_random_graph(20000, 300000);  // several edge chunks
+    const auto weight = random_weights(20000);
+
+    for (const auto num_threads : {1U, 4U}) {
+        auto cover = std::vector<bool>(20000, false);
+        const auto cost = min_vertex_cover_pd_parallel(gra, cover, weight, num_threads);
+        for (const auto& edge : gra.edges()) {
+            const auto [utx, vtx] = edge.end_points();
+            const auto covered = cover[utx] || cover[vtx];
+            CHECK(covered);
+        }
+        auto total = 0;
+        for (auto vtx = 0U; vtx != 20000; ++vtx) {
+            total += cover[vtx] ? weight[vtx] : 0;
+        }
+        CHECK_EQ(cost.primal, total);
+        CHECK_LE(cost.dual, cost.primal);
+        CHECK_LE(cost.primal, 2 * cost.dual);
+    }
+}
+
+TEST_CASE("Test Min Vertex Cover - Parallel, Pre-covered Node") {
+    auto gra = PdGraph(3, {{0, 1}, {1, 2}});
+    auto cover = std::vector<bool>{false, true, false};
+    auto weight = std::vector<int>{5, 3, 4};
+
+    const auto cost = min_vertex_cover_pd_parallel(gra, cover, weight, 2);
+    CHECK_EQ(cost.primal, 0);
+    CHECK_EQ(cost.dual, 0);
+    CHECK_FALSE(cover[0]);
+    CHECK_FALSE(cover[2]);
+}
+
 TEST_CASE("Test Min Maximal Independent Set - Single Edge") {
     auto gra = PdGraph(2, {{0, 1}});
     auto indset = std::vector<bool>(2, false);
@@ -231,3 +385,78 @@ TEST_CASE("Test Min Maximal Independent Set - Star Graph") {
 
     CHECK_GT(cost, 0);
 }
+
+TEST_CASE("Test Min Maximal Independent Set - Parallel") {
+    const auto gra = create_random_graph(20000, 60000);
+    const auto weight = random_weights(20000);
+
+    auto indset1 = std::vector<bool>(20000, false);
+    auto dep1 = std::vector<bool>(20000, false);
+    const auto cost1 = min_maximal_independant_set_pd_parallel(gra, indset1, dep1, weight, 1);
+
+    auto indset4 = std::vector<bool>(20000, false);
+    auto dep4 = std::vector<bool>(20000, false);
+    const auto cost4 = min_maximal_independant_set_pd_parallel(gra, indset4, dep4, weight, 4);
+
+    // deterministic: the same set whatever the number of threads
+    CHECK_EQ(cost4, cost1);
+    CHECK(indset4 == indset1);
+
+    for (auto utx = 0U; utx != 20000; ++utx) {
+        auto has_selected_nbr = false;
+        for (const auto vtx : gra[utx]) {
+            if (vtx != utx && indset4[vtx]) {
+                has_selected_nbr = true;
+            }
+        }
+        const auto maximal = indset4[utx] || has_selected_nbr;
+        const auto independent = !indset4[utx] || !has_selected_nbr;
+        CHECK(maximal);
+        CHECK(independent);
+        CHECK(dep4[utx]);
+    }
+
+    auto indset0 = std::vector<bool>(20000, false);
+    auto dep0 = std::vector<bool>(20000, false);
+    const auto cost0 = min_maximal_independant_set_pd(gra, indset0, dep0, weight);
+    // measured: 0.1% above the sequential set on this graph. That is no
+    // bound in general, only a regression check; the fixture draws from
+    // mt19937 directly, so every standard library sees the same graph.
+    CHECK_LE(cost4, 1.02 * cost0);
+}
+
+TEST_CASE("Test Min Maximal Independent Set - Parallel, Pre-defined") {
+    auto gra = PdGraph(4, {{0, 1}, {0, 2}, {0, 3}});
+    auto indset = std::vector<bool>{false, true, false, false};
+    auto dep = std::vector<bool>(4, false);
+    auto weight = std::vector<int>{1, 5, 5, 5};
+
+    // the light center is excluded by the pre-defined leaf 1
+    const auto cost = min_maximal_independant_set_pd_parallel(gra, indset, dep, weight, 2);
+    CHECK_EQ(cost, 10);
+    CHECK_FALSE(indset[0]);
+    CHECK(indset[1]);
+    CHECK(indset[2]);
+    CHECK(indset[3]);
+}
+
+TEST_CASE("Test Min Maximal Independent Set - Parallel, Dependent Before Independent") {
+    auto gra = PdGraph(4, {{0, 1}, {0, 2}, {0, 3}});
+    auto weight = std::vector<int>{1, 5, 5, 5};
+
+    // leaf 1 is in both: dep wins, as in the sequential version, so it does
+    // not exclude the light center
+    auto indset = std::vector<bool>{false, true, false, false};
+    auto dep = std::vector<bool>{false, true, false, false};
+    const auto cost = min_maximal_independant_set_pd_parallel(gra, indset, dep, weight, 2);
+
+    auto indset0 = std::vector<bool>{false, true, false, false};
+    auto dep0 = std::vector<bool>{false, true, false, false};
+    const auto cost0 = min_maximal_independant_set_pd(gra, indset0, dep0, weight);
+    CHECK_EQ(cost, 1);
+    CHECK_EQ(cost, cost0);
+    CHECK(indset[0]);
+    CHECK_FALSE(indset[2]);
+    CHECK_FALSE(indset[3]);
+    CHECK(indset == indset0);
+}
@@ -0,0 +1,80 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK
+
+#include <cstdint>                           // for uint32_t
+#include <netoptim/csr_graph.hpp>            // for CsrGraph
+#include <netoptim/min_cycle_ratio.hpp>      // for min_cycle_ratio
+#include <netoptim/min_cycle_ratio_scc.hpp>  // for min_cycle_ratio_scc
+#include <netoptim/scc.hpp>                  // for strongly_connected_components
+#include <utility>                           // for pair
+#include <vector>                            // for vector
+
+namespace {
+
+    /// Two 3-cycles {0, 1, 2} and {4, 5, 6} joined by the acyclic node 3,
+    /// plus node 7 with a self-loop and node 8 hanging off node 7.
+    auto create_scc_graph() -> CsrGraph<std::pair<int, int>> {
+        const auto ends = std::vector<std::pair<uint32_t, uint32_t>>{
+            {0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 4}, {4, 5}, {5, 6}, {6, 4}, {7, 7}, {7, 8}};
+        // (cost, time) per edge
+        return {9, ends, {{4, 1}, {2, 1}, {3, 1}, {0, 1}, {0, 1}, {1, 2}, {2, 2}, {3, 2}, {7, 3},
+                          {0, 1}}};
+    }
+
+}  // namespace
+
+TEST_CASE("Test strongly_connected_components") {
+    const auto gra = create_scc_graph();
+    const auto scc = strongly_connected_components(gra);
+    CHECK_EQ(scc.num_components, 5);
+    CHECK_EQ(scc.component[0], scc.component[1]);
+    CHECK_EQ(scc.component[1], scc.component[2]);
+    CHECK_EQ(scc.component[4], scc.component[5]);
+    CHECK_EQ(scc.component[5], scc.component[6]);
+    CHECK_NE(scc.component[0], scc.component[4]);
+    CHECK_NE(scc.component[3], scc.component[4]);
+    // edges between components go from higher to lower component ids
+    CHECK_GT(scc.component[2], scc.component[3]);
+    CHECK_GT(scc.component[3], scc.component[4]);
+}
+
+TEST_CASE("Test nontrivial_sccs") {
+    const auto gra = create_scc_graph();
+    const auto parts = nontrivial_sccs(gra);
+    REQUIRE_EQ(parts.size(), 3);
+    CHECK_EQ(parts[0].graph.num_nodes(), 3);
+    CHECK_EQ(parts[0].graph.num_edges(), 3);
+    CHECK_EQ(parts[1].graph.num_edges(), 3);
+    CHECK_EQ(parts[2].graph.num_nodes(), 1);  // the self-loop at node 7
+    CHECK_EQ(parts[2].nodes[0], 7);
+    CHECK_EQ(parts[2].edge_ids[0], 8);
+    for (const auto& part : parts) {
+        for (auto eid = 0U; eid != part.graph.num_edges(); ++eid) {
+            CHECK_EQ(part.graph.edge(eid), gra.edge(part.edge_ids[eid]));
+        }
+    }
+}
+
+TEST_CASE("Test min_cycle_ratio_scc") {
+    const auto gra = create_scc_graph();
+    const auto get_cost = [](const std::pair<int, int>& e) -> double { return e.first; };
+    const auto get_time = [](const std::pair<int, int>& e) -> double { return e.second; };
+
+    auto dist = std::vector<double>(gra.num_nodes(), 0.0);
+    auto r_ref = 100.0;
+    const auto c_ref = min_cycle_ratio(gra, r_ref, get_cost, get_time, dist);
+    CHECK_EQ(r_ref, doctest::Approx(1.0));  // (1 + 2 + 3) / (2 + 2 + 2)
+
+    for (const auto num_threads : {1U, 4U}) {
+        auto r = 100.0;
+        const auto c = min_cycle_ratio_scc(gra, r, get_cost, get_time, num_threads);
+        CHECK_EQ(r, doctest::Approx(r_ref));
+        CHECK_EQ(c.size(), c_ref.size());
+    }
+
+    // nothing beats the initial ratio: r0 unchanged, empty cycle
+    auto r_low = 0.5;
+    const auto c_none = min_cycle_ratio_scc(gra, r_low, get_cost, get_time, 2);
+    CHECK(c_none.empty());
+    CHECK_EQ(r_low, doctest::Approx(0.5));
+}
@@ -0,0 +1,156 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK
+
+#include <chrono>                      // for steady_clock
+#include <cstdint>                     // for uint32_t
+#include <netoptim/csr_graph.hpp>      // for CsrGraph
+#include <netoptim/parametric.hpp>     // for max_parametric_until
+#include <netoptim/solve_control.hpp>  // for SolveControl
+#include <semaphore>                   // for binary_semaphore
+#include <stop_token>                  // for stop_source
+#include <thread>                      // for jthread, yield
+#include <utility>                     // for pair
+#include <vector>                      // for vector
+
+#include "random_graph.tpp"  // for create_random_graph, distance, zero_cancel
+
+namespace {
+
+    using Edge = std::pair<double, double>;  // (cost, time)
+
+}  // namespace
+
+TEST_CASE("Test max_parametric_until converges with progress") {
+    const auto gra = create_random_graph<Edge>(100, 300, 7);
+
+    auto dist1 = std::vector<double>(gra.num_nodes(), 0.0);
+    auto r1 = 100.0;
+    max_parametric(gra, r1, distance, zero_cancel, dist1);
+
+    auto reported = std::vector<std::pair<size_t, double>>{};
+    auto control = SolveControl<double>{};
+    control.progress = [&](size_t niter, const double& r) { reported.emplace_back(niter, r); };
+    auto dist2 = std::vector<double>(gra.num_nodes(), 0.0);
+    auto r2 = 100.0;
+    const auto result = max_parametric_until(gra, r2, distance, zero_cancel, dist2, control);
+
+    CHECK(result.converged());
+    CHECK_EQ(r2, r1);
+    REQUIRE_FALSE(reported.empty());
+    CHECK_EQ(reported.back().second, r2);
+    for (auto idx = 1U; idx < reported.size(); ++idx) {
+        CHECK_EQ(reported[idx].first, reported[idx - 1].first + 1);
+        CHECK_LT(reported[idx].second, reported[idx - 1].second);
+    }
+}
+
+TEST_CASE("Test SolveControl::check") {
+    auto control = SolveControl<double>{};
+    CHECK_FALSE(control.check().has_value());  // nothing to stop for
+
+    control.deadline = std::chrono::steady_clock::now();
+    CHECK_EQ(control.check(), SolveStatus::DeadlineExpired);
+
+    auto source = std::stop_source{};
+    control.stop_token = source.get_token();
+    source.request_stop();
+    CHECK_EQ(control.check(), SolveStatus::Cancelled);  // cancellation takes precedence
+}
+
+TEST_CASE("Test max_parametric_until cancellation keeps the best so far") {
+    const auto gra = create_random_graph<Edge>(100, 300, 7);
+    auto source = std::stop_source{};
+
+    // cancelled before it starts: nothing is done
+    source.request_stop();
+    auto control = SolveControl<double>{};
+    control.stop_token = source.get_token();
+    auto dist = std::vector<double>(gra.num_nodes(), 0.0);
+    auto r = 100.0;
+    const auto none = max_parametric_until(gra, r, distance, zero_cancel, dist, control);
+    CHECK_EQ(none.status, SolveStatus::Cancelled);
+    CHECK_EQ(none.iterations, 0);
+    CHECK(none.cycle.empty());
+    CHECK_EQ(r, 100.0);
+
+    // cancelled after the first improvement: an anytime result
+    auto source2 = std::stop_source{};
+    control.stop_token = source2.get_token();
+    control.progress = [&](size_t /*niter*/, const double& /*r*/) { source2.request_stop(); };
+    const auto some = max_parametric_until(gra, r, distance, zero_cancel, dist, control);
+    CHECK_EQ(some.status, SolveStatus::Cancelled);
+    CHECK_FALSE(some.converged());
+    CHECK_EQ(some.iterations, 1);
+    REQUIRE_FALSE(some.cycle.empty());
+    CHECK_LT(r, 100.0);
+    CHECK_EQ(zero_cancel(some.cycle), doctest::Approx(r));
+}
+
+TEST_CASE("Test max_parametric_until deadline") {
+    const auto gra = create_random_graph<Edge>(20000, 60000, 7);
+    auto control = SolveControl<double>{};
+    control.deadline = std::chrono::steady_clock::now();
+    auto dist = std::vector<double>(gra.num_nodes(), 0.0);
+    auto r = 100.0;
+    const auto result = max_parametric_until(gra, r, distance, zero_cancel, dist, control);
+    CHECK_EQ(result.status, SolveStatus::DeadlineExpired);
+    CHECK_EQ(r, 100.0);
+}
+
+TEST_CASE("Test max_parametric_until deadline passing during the solve") {
+    const auto gra = create_random_graph<Edge>(20000, 60000, 7);
+    auto control = SolveControl<double>{};
+    // the deadline passes right after the first improvement: the check
+    // between iterations must end the solve with that result
+    control.progress = [&](size_t /*niter*/, const double& /*r*/) {
+        control.deadline = std::chrono::steady_clock::now();
+    };
+    auto dist = std::vector<double>(gra.num_nodes(), 0.0);
+    auto r = 100.0;
+    const auto result = max_parametric_until(gra, r, distance, zero_cancel, dist, control);
+    CHECK_EQ(result.status, SolveStatus::DeadlineExpired);
+    CHECK_EQ(result.iterations, 1);
+    REQUIRE_FALSE(result.cycle.empty());
+    CHECK_LT(r, 100.0);
+    CHECK_EQ(zero_cancel(result.cycle), doctest::Approx(r));
+}
+
+TEST_CASE("Test max_parametric_until stop from another thread in a sweep") {
+    const auto gra = create_random_graph<Edge>(20000, 60000, 7);
+    auto source = std::stop_source{};
+    auto go = std::binary_semaphore{0};
+    auto canceller = std::jthread{[&] {
+        go.acquire();
+        source.request_stop();
+    }};
+
+    // half way through the first sweep after an improvement, have the other
+    // thread request the stop and wait for it: only the poll inside the
+    // sweep can then end the run before the sweep is over
+    auto improved = false;
+    auto evals = size_t(0);
+    auto evals_at_stop = size_t(0);
+    const auto counting = [&](const double& r, const Edge& edge) -> double {
+        if (improved && ++evals == gra.num_edges() / 2) {
+            go.release();
+            while (!source.stop_requested()) {
+                std::this_thread::yield();
+            }
+            evals_at_stop = evals;
+        }
+        return distance(r, edge);
+    };
+    auto control = SolveControl<double>{};
+    control.stop_token = source.get_token();
+    control.progress = [&](size_t /*niter*/, const double& /*r*/) { improved = true; };
+    auto dist = std::vector<double>(gra.num_nodes(), 0.0);
+    auto r = 100.0;
+    const auto result = max_parametric_until(gra, r, counting, zero_cancel, dist, control);
+
+    CHECK_EQ(result.status, SolveStatus::Cancelled);
+    CHECK_GT(result.iterations, 0);
+    REQUIRE_FALSE(result.cycle.empty());
+    CHECK_EQ(zero_cancel(result.cycle), doctest::Approx(r));
+    REQUIRE(evals_at_stop > 0);
+    CHECK_LT(evals - evals_at_stop, gra.num_edges() / 2);  // the sweep was cut short
+}
@@ -0,0 +1,94 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK
+
+#include <cstdint>                         // for uint32_t
+#include <list>                            // for list
+#include <map>                             // for map
+#include <netoptim/csr_graph.hpp>          // for CsrGraph
+#include <netoptim/min_cycle_ratio.hpp>    // for min_cycle_ratio
+#include <netoptim/network_oracle.hpp>     // for NetworkOracle
+#include <netoptim/solver_stats.hpp>       // for SolverStats
+#include <unordered_map>                   // for unordered_map
+#include <utility>                         // for pair
+#include <vector>                          // for vector
+
+#include "random_graph.tpp"  // for create_random_graph
+
+namespace {
+
+    using Edge = std::pair<double, double>;  // (cost, time)
+
+    struct Constraint {
+        std::map<std::pair<uint32_t, uint32_t>, double> values;
+
+        auto eval(const std::pair<uint32_t, uint32_t>& edge, double x) const -> double {
+            return values.at(edge) + x;
+        }
+        auto grad(const std::pair<uint32_t, uint32_t>& /*edge*/, double /*x*/) const -> double {
+            return 1.0;
+        }
+        void update(double /*gamma*/) {}
+    };
+
+    using TestGraph
+        = std::unordered_map<uint32_t,
+                             std::list<std::pair<uint32_t, std::pair<uint32_t, uint32_t>>>>;
+
+}  // namespace
+
+TEST_CASE("Test SolverStats of min_cycle_ratio") {
+    const auto gra = create_random_graph<Edge>(40, 120, 5);
+    const auto get_cost = [](const Edge& edge) -> double { return edge.first; };
+    const auto get_time = [](const Edge& edge) -> double { return edge.second; };
+
+    auto dist1 = std::vector<double>(gra.num_nodes(), 0.0);
+    auto r1 = 100.0;
+    const auto c1 = min_cycle_ratio(gra, r1, get_cost, get_time, dist1);
+
+    auto stats = SolverStats{};
+    auto dist2 = std::vector<double>(gra.num_nodes(), 0.0);
+    auto r2 = 100.0;
+    const auto c2 = min_cycle_ratio(gra, r2, get_cost, get_time, dist2, 1000, stats);
+
+    CHECK_EQ(r2, r1);
+    CHECK_EQ(c2.size(), c1.size());
+    CHECK(stats.iterations >= 2);
+    CHECK(stats.howard_passes >= stats.iterations - 1);
+    CHECK(stats.edge_evaluations >= stats.howard_passes * gra.num_edges());
+    CHECK(stats.cycles >= stats.improving_cycles);
+    CHECK(stats.improving_cycles >= 1);
+    CHECK(stats.total_time >= stats.howard_time);
+
+    // counters accumulate over calls
+    const auto first = stats;
+    auto r3 = 100.0;
+    min_cycle_ratio(gra, r3, get_cost, get_time, dist2, 1000, stats);
+    CHECK(stats.iterations > first.iterations);
+    CHECK(stats.total_time >= first.total_time);
+}
+
+TEST_CASE("Test SolverStats of NetworkOracle") {
+    auto gra = TestGraph{
+        {0, {{{1, {0, 1}}}}},
+        {1, {{{2, {1, 2}}}}},
+        {2, {{{0, {2, 0}}}}},
+    };
+    auto constraint = Constraint{};
+    constraint.values = {{{0, 1}, 1.0}, {{1, 2}, 1.0}, {{2, 0}, -3.0}};
+    auto dist = std::unordered_map<uint32_t, double>{{0, 0.0}, {1, 0.0}, {2, 0.0}};
+    auto network = NetworkOracle(gra, dist, constraint);
+
+    auto stats = SolverStats{};
+    const auto cut = network.assess_feas(0.0, stats);
+    REQUIRE(cut.has_value());
+    CHECK_EQ(cut->second, doctest::Approx(1.0));
+    CHECK_EQ(stats.iterations, 1);
+    CHECK_EQ(stats.cycles, 1);
+    CHECK_EQ(stats.improving_cycles, 1);
+    CHECK(stats.edge_evaluations >= 3);
+
+    // feasible point: no cut, the call is still counted
+    CHECK_FALSE(network.assess_feas(1.0, stats).has_value());
+    CHECK_EQ(stats.iterations, 2);
+    CHECK_EQ(stats.cycles, 1);
+}
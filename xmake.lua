@@ -38,6 +38,16 @@ target("test_netoptim")
     add_packages("doctest")
     add_tests("default")
 
+-- replaces the global operator new, so it cannot share a binary with the other tests
+target("test_netoptim_alloc")
+    set_kind("binary")
+    add_includedirs("../digraphx-cpp/include", {public = true})
+    add_includedirs("../py2cpp/include", {public = true})
+    add_includedirs("include", {public = true})
+    add_files("test/alloc/*.cpp")
+    add_packages("doctest")
+    add_tests("default")
+
 --
 -- If you want to known more usage about xmake, please see https://xmake.io
 --